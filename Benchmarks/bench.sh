@@ -0,0 +1,135 @@
+#!/bin/sh
+#
+# File:        bench.sh
+#
+# Description: Build every implementation of the set abstract data type
+#              and time the unique and parity drivers for each one on every
+#              input file, printing a table and writing the same results as
+#              JSON.  Each time is the median of several runs, and each run
+#              also reports its peak resident set size and the number of
+#              words it processed per second.
+#
+#              Everything is built in a temporary copy of the tree, so the
+#              objects and programs checked in with the labs are left alone.
+#              The compiler options can be set with OPT (the default is -O2)
+#              and the set size with MAX_SIZE, for inputs made by zipf.
+#
+# Usage:       bench.sh [-r runs] [-o output.json] [file ...]
+#
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+RUNS=5
+JSON=bench.json
+OPT=${OPT--O2}
+
+while getopts r:o: flag; do
+    case $flag in
+	r) RUNS=$OPTARG ;;
+	o) JSON=$OPTARG ;;
+	*) echo "usage: $0 [-r runs] [-o output.json] [file ...]" >&2; exit 1 ;;
+    esac
+done
+
+shift $((OPTIND - 1))
+
+if [ $# -eq 0 ]; then
+    set -- "$ROOT/Input Files"/*.txt
+fi
+
+if [ -n "$MAX_SIZE" ]; then
+    OPT="$OPT -DMAX_SIZE=$MAX_SIZE"
+fi
+
+
+# Build a copy of each lab, and the parity driver for Lab 6 from the one in
+# Lab 3, since the two labs share the same interface.
+
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+(cd "$ROOT" && tar cf - Common Benchmarks "Lab 2/Lab 2 Code" "Lab 3/Lab 3 Code" \
+    "Lab 4/Lab 4 Code" "Lab 6/Lab 6 Code") | (cd "$WORK" && tar xf -)
+
+cp "$WORK/Lab 3/Lab 3 Code/generic/parity.c" "$WORK/Lab 6/Lab 6 Code"
+
+build() {
+    (cd "$WORK/$1" && shift && make clean > /dev/null &&
+	make CFLAGS="-g -Wall $OPT -I\$(COMMON)" "$@" > /dev/null) || exit 1
+}
+
+(cd "$WORK/Benchmarks" && make measure > /dev/null) || exit 1
+build "Lab 2/Lab 2 Code" unique_unsorted unique_sorted unique_btree \
+    parity_unsorted parity_sorted parity_btree
+build "Lab 3/Lab 3 Code/strings" unique parity unique_art parity_art \
+    unique_robin parity_robin
+build "Lab 3/Lab 3 Code/generic" unique parity
+build "Lab 4/Lab 4 Code" unique parity
+build "Lab 6/Lab 6 Code" unique parity.o table.o token.o
+
+(cd "$WORK/Lab 6/Lab 6 Code" && gcc -o parity -pthread parity.o table.o token.o) || exit 1
+
+MEASURE="$WORK/Benchmarks/measure"
+
+
+# The Lab 3 string sets take the length of each word from the tokenizer,
+# which passes null bytes through, so words that differ only by trailing
+# null bytes must still be told apart.  Check that they agree on such words,
+# and that none of them hangs, before timing anything.
+
+printf 'a\0 a\nab\0\0 ab ab\0 b\0x b\n' > "$WORK/nul.txt"
+
+for program in unique_art unique_robin; do
+    expect=$(cd "$WORK/Lab 3/Lab 3 Code/strings" && ./unique "$WORK/nul.txt")
+    found=$(cd "$WORK/Lab 3/Lab 3 Code/strings" &&
+	timeout 10 ./$program "$WORK/nul.txt") || found=
+
+    if [ "$found" != "$expect" ]; then
+	echo "$program does not agree with unique on null bytes" >&2
+	exit 1
+    fi
+done
+
+# Each implementation is a name and the paths of its unique and parity
+# programs.
+
+IMPLS="unsorted:Lab 2/Lab 2 Code/unique_unsorted:Lab 2/Lab 2 Code/parity_unsorted
+sorted:Lab 2/Lab 2 Code/unique_sorted:Lab 2/Lab 2 Code/parity_sorted
+btree:Lab 2/Lab 2 Code/unique_btree:Lab 2/Lab 2 Code/parity_btree
+strings:Lab 3/Lab 3 Code/strings/unique:Lab 3/Lab 3 Code/strings/parity
+art:Lab 3/Lab 3 Code/strings/unique_art:Lab 3/Lab 3 Code/strings/parity_art
+robin:Lab 3/Lab 3 Code/strings/unique_robin:Lab 3/Lab 3 Code/strings/parity_robin
+generic:Lab 3/Lab 3 Code/generic/unique:Lab 3/Lab 3 Code/generic/parity
+chained:Lab 4/Lab 4 Code/unique:Lab 4/Lab 4 Code/parity
+probing:Lab 6/Lab 6 Code/unique:Lab 6/Lab 6 Code/parity"
+
+
+# Run every program on every file.
+
+printf "%-8s %-10s %-28s %10s %10s %10s %12s\n" \
+    program impl file words seconds rss_kb words/sec
+printf "[\n" > "$JSON"
+
+for program in unique parity; do
+    for file in "$@"; do
+	words=$(LC_ALL=C wc -w < "$file")
+	name=$(basename "$file")
+
+	echo "$IMPLS" | while IFS=: read impl unique parity; do
+	    if [ $program = unique ]; then path=$unique; else path=$parity; fi
+
+	    set -- $("$MEASURE" "$RUNS" "$WORK/$path" "$file") || exit 1
+	    rate=$(awk "BEGIN { printf \"%.0f\", $words / ($1 > 0 ? $1 : 1e-9) }")
+
+	    printf "%-8s %-10s %-28s %10d %10.4f %10d %12d\n" \
+		$program $impl "$name" $words $1 $2 $rate
+
+	    [ -s "$JSON.part" ] && printf ",\n" >> "$JSON.part"
+	    printf '  {"program": "%s", "impl": "%s", "file": "%s", "words": %d, "runs": %d, "median_seconds": %s, "peak_rss_kb": %d, "words_per_second": %d}' \
+		$program $impl "$name" $words $RUNS $1 $2 $rate >> "$JSON.part"
+	done
+    done
+done
+
+cat "$JSON.part" >> "$JSON" 2> /dev/null
+rm -f "$JSON.part"
+printf "\n]\n" >> "$JSON"
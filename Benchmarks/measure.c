@@ -0,0 +1,129 @@
+/*
+ * File:        measure.c
+ *
+ * Description: This file contains a program that runs a command a number
+ *              of times and prints the median of its wall times in seconds
+ *              and the largest of its peak resident set sizes in kilobytes.
+ *              The output of the command is discarded so that the time to
+ *              write it to a terminal is not measured.
+ *
+ *              The peak resident set size is taken from the resource usage
+ *              that wait4 returns for each run, so it covers the command
+ *              alone and not this program.
+ */
+
+# include <stdio.h>
+# include <stdlib.h>
+# include <fcntl.h>
+# include <unistd.h>
+# include <time.h>
+# include <sys/wait.h>
+# include <sys/resource.h>
+
+
+/*
+ * Function:    compareTimes
+ *
+ * Description: Compare the times pointed to by P and Q for qsort.
+ */
+
+static int compareTimes(const void *p, const void *q)
+{
+    double x = *(const double *) p, y = *(const double *) q;
+
+
+    return (x > y) - (x < y);
+}
+
+
+/*
+ * Function:    runOnce
+ *
+ * Complexity:  O(1) plus the time taken by the command
+ *
+ * Description: Run the command ARGV with its output discarded and return
+ *		its wall time in seconds, storing its peak resident set size
+ *		in kilobytes in *RSS.  Exit if the command fails.
+ */
+
+static double runOnce(char *argv[], long *rss)
+{
+    struct timespec start, stop;
+    struct rusage usage;
+    int status, fd;
+    pid_t pid;
+
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    if ((pid = fork()) < 0) {
+	perror("fork");
+	exit(EXIT_FAILURE);
+    }
+
+    if (pid == 0) {
+	if ((fd = open("/dev/null", O_WRONLY)) >= 0)
+	    dup2(fd, STDOUT_FILENO);
+
+	execvp(argv[0], argv);
+	perror(argv[0]);
+	_exit(127);
+    }
+
+    if (wait4(pid, &status, 0, &usage) < 0) {
+	perror("wait4");
+	exit(EXIT_FAILURE);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+	fprintf(stderr, "measure: %s failed\n", argv[0]);
+	exit(EXIT_FAILURE);
+    }
+
+    *rss = usage.ru_maxrss;
+    return (stop.tv_sec - start.tv_sec) + (stop.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+
+/*
+ * Function:    main
+ *
+ * Description: Driver function for the program.
+ */
+
+int main(int argc, char *argv[])
+{
+    int i, runs;
+    long rss, peak;
+    double *times;
+
+
+    /* Check usage. */
+
+    if (argc < 3 || (runs = atoi(argv[1])) < 1) {
+	fprintf(stderr, "usage: %s runs command [args ...]\n", argv[0]);
+	exit(EXIT_FAILURE);
+    }
+
+    times = malloc(sizeof(double) * runs);
+    peak = 0;
+
+    for (i = 0; i < runs; i ++) {
+	times[i] = runOnce(argv + 2, &rss);
+
+	if (rss > peak)
+	    peak = rss;
+    }
+
+    qsort(times, runs, sizeof(double), compareTimes);
+
+    if (runs % 2 == 1)
+	printf("%.6f %ld\n", times[runs / 2], peak);
+    else
+	printf("%.6f %ld\n", (times[runs / 2 - 1] + times[runs / 2]) / 2, peak);
+
+    free(times);
+    exit(EXIT_SUCCESS);
+}
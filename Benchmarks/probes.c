@@ -0,0 +1,236 @@
+/*
+ * File:        probes.c
+ *
+ * Description: This file contains a program that reports how well each of
+ *              the hash functions in hash.h spreads the words of a corpus
+ *              over a linear-probing hash table, and how fast each one is.
+ *
+ *              The distinct words of the files given on the command line
+ *              are inserted into a table whose length is not a power of
+ *              two, as in the sets of the labs, at several load factors.
+ *              For each hash function and load factor, the number of slots
+ *              looked at to find each word is summarized by its mean,
+ *              median, 90th and 99th percentiles, and maximum.  The time
+ *              taken to hash each word is also printed in nanoseconds.
+ *
+ * Usage:       probes file ...
+ */
+
+# include <stdio.h>
+# include <stdlib.h>
+# include <string.h>
+# include <time.h>
+# include <stdbool.h>
+# include "token.h"
+# include "arena.h"
+# include "hash.h"
+
+# define REPEATS 20
+
+static char *names[] = {"multiply", "wide", "crc"};
+static double loads[] = {0.5, 0.75, 0.9};
+static volatile unsigned sink;
+
+
+/*
+ * Function:    insertWord
+ *
+ * Complexity:  O(m) where m is the length of the table
+ *
+ * Description: Insert WORD of the given LENGTH into the table SLOTS of
+ *		SIZE slots, which is hashed with HASH and probed linearly,
+ *		unless it is already there, setting *INSERTED to whether it
+ *		was.  Return the number of slots that were looked at to find
+ *		the word or the empty slot it was placed in, which is also
+ *		the number needed to find it again.
+ */
+
+static int insertWord(char **slots, int size, HASHFUNC *hash,
+	char *word, int length, bool *inserted)
+{
+    int i, probes;
+
+
+    i = (*hash)(word, length) % size;
+
+    for (probes = 1; slots[i] != NULL; probes ++) {
+	if (strcmp(slots[i], word) == 0) {
+	    *inserted = false;
+	    return probes;
+	}
+
+	i = (i + 1) % size;
+    }
+
+    slots[i] = word;
+    *inserted = true;
+    return probes;
+}
+
+
+/*
+ * Function:    percentile
+ *
+ * Complexity:  O(m) where m is the length of the histogram
+ *
+ * Description: Return the smallest number of probes that at least the
+ *		fraction P of the N words needed, given the number of words
+ *		needing each number of probes in COUNTS.
+ */
+
+static int percentile(int *counts, int n, double p)
+{
+    long total = 0;
+    int i;
+
+
+    for (i = 1; total + counts[i] < p * n; i ++)
+	total += counts[i];
+
+    return i;
+}
+
+
+/*
+ * Function:    timeHash
+ *
+ * Complexity:  O(n) where n is the total length of the words
+ *
+ * Description: Return the mean time in nanoseconds to hash each of the N
+ *		WORDS with the given LENGTHS using HASH.
+ */
+
+static double timeHash(HASHFUNC *hash, char **words, int *lengths, int n)
+{
+    struct timespec start, stop;
+    unsigned sum = 0;
+    int i, j;
+
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (j = 0; j < REPEATS; j ++)
+	for (i = 0; i < n; i ++)
+	    sum += (*hash)(words[i], lengths[i]);
+
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+    sink = sum;
+
+    return ((stop.tv_sec - start.tv_sec) * 1e9 +
+	(stop.tv_nsec - start.tv_nsec)) / ((double) REPEATS * n);
+}
+
+
+/*
+ * Function:    main
+ *
+ * Description: Driver function for the program.
+ */
+
+int main(int argc, char *argv[])
+{
+    int i, j, k, words, distinct, size, length, probes, max, *counts;
+    char *word, **slots, **unique;
+    int *lengths;
+    TOKENIZER *tp;
+    ARENA *ap;
+    HASHFUNC *hash;
+    double total, ns;
+    bool inserted;
+
+
+    if (argc < 2) {
+	fprintf(stderr, "usage: %s file ...\n", argv[0]);
+	exit(EXIT_FAILURE);
+    }
+
+
+    /* Read the distinct words of every file, finding them with a table
+       large enough that it is never more than half full.  They are kept
+       in the order they were copied into the arena, so that timing the
+       hashes reads memory in order. */
+
+    ap = createArena(true);
+    size = 1 << 16;
+    slots = calloc(size, sizeof(char *));
+    unique = malloc(sizeof(char *) * size);
+    lengths = malloc(sizeof(int) * size);
+    words = distinct = 0;
+
+    for (i = 1; i < argc; i ++) {
+	if ((tp = openTokenizer(argv[i])) == NULL) {
+	    fprintf(stderr, "%s: cannot open %s\n", argv[0], argv[i]);
+	    exit(EXIT_FAILURE);
+	}
+
+	while ((word = nextToken(tp, &length)) != NULL) {
+	    words ++;
+
+	    if (2 * (distinct + 1) > size) {
+		size *= 2;
+		free(slots);
+		slots = calloc(size, sizeof(char *));
+		unique = realloc(unique, sizeof(char *) * size);
+		lengths = realloc(lengths, sizeof(int) * size);
+
+		for (j = 0; j < distinct; j ++)
+		    insertWord(slots, size, hashWide, unique[j], lengths[j],
+			&inserted);
+	    }
+
+	    word = copyArena(ap, word, length);
+	    insertWord(slots, size, hashWide, word, length, &inserted);
+
+	    if (inserted) {
+		unique[distinct] = word;
+		lengths[distinct ++] = length;
+	    }
+	}
+
+	closeTokenizer(tp);
+    }
+
+    free(slots);
+    printf("%d words, %d distinct\n\n", words, distinct);
+
+
+    /* Insert the distinct words with each hash at each load factor. */
+
+    printf("%-10s %6s %8s %6s %6s %6s %8s %10s\n",
+	"hash", "load", "mean", "p50", "p90", "p99", "max", "ns/hash");
+
+    for (i = 0; i < sizeof(names) / sizeof(names[0]); i ++) {
+	hash = findHash(names[i]);
+	ns = timeHash(hash, unique, lengths, distinct);
+
+	for (j = 0; j < sizeof(loads) / sizeof(loads[0]); j ++) {
+	    size = distinct / loads[j];
+	    slots = calloc(size, sizeof(char *));
+	    counts = calloc(size + 1, sizeof(int));
+	    total = max = 0;
+
+	    for (k = 0; k < distinct; k ++) {
+		probes = insertWord(slots, size, hash, unique[k], lengths[k],
+		    &inserted);
+		counts[probes] ++;
+		total += probes;
+
+		if (probes > max)
+		    max = probes;
+	    }
+
+	    printf("%-10s %6.2f %8.2f %6d %6d %6d %8d %10.2f\n", names[i],
+		loads[j], total / distinct, percentile(counts, distinct, .5),
+		percentile(counts, distinct, .9),
+		percentile(counts, distinct, .99), max, ns);
+
+	    free(counts);
+	    free(slots);
+	}
+    }
+
+    free(unique);
+    free(lengths);
+    destroyArena(ap);
+    exit(EXIT_SUCCESS);
+}
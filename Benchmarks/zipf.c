@@ -0,0 +1,328 @@
+/*
+ * File:        zipf.c
+ *
+ * Description: This file contains a generator of synthetic text for
+ *              testing the labs on inputs much larger than the ones in
+ *              Input Files.  Words are drawn from a vocabulary of a given
+ *              size, with the word of rank k occurring with probability
+ *              proportional to 1 / k^s, and written to the standard output
+ *              separated by spaces, a fixed number to a line.
+ *
+ *              The output depends only on the options, so the same corpus
+ *              can be generated again from its seed instead of being
+ *              stored.  No table of the vocabulary is kept: the word of a
+ *              given rank is computed from the rank whenever it is drawn.
+ *              Its length is drawn from 1 + Poisson(mean - 1), using a
+ *              generator seeded by the rank, and its letters are the rank
+ *              passed through an affine bijection mod 26^length and then
+ *              written in base 26.  Two ranks with the same length thus
+ *              never give the same word, as long as the length is long
+ *              enough to have room for every rank, which is enforced.
+ *
+ *              Ranks are drawn by rejection-inversion (Hormann and
+ *              Derflinger, 1996), which takes constant expected time and
+ *              no memory for any vocabulary size and exponent.
+ */
+
+# include <stdio.h>
+# include <stdlib.h>
+# include <string.h>
+# include <stdint.h>
+# include <math.h>
+
+# define MAX_LENGTH 13
+# define LINE_WORDS 12
+
+static uint64_t seed = 1;
+static double exponent = 1.0;
+static double hX1, hN, squeeze;
+static uint64_t multiplier[MAX_LENGTH + 1], offset[MAX_LENGTH + 1];
+static uint64_t power[MAX_LENGTH + 1];
+
+
+/*
+ * Function:    splitmix
+ *
+ * Complexity:  O(1)
+ *
+ * Description: Advance the state pointed to by STATE and return the next
+ *		value of the SplitMix64 generator.
+ */
+
+static uint64_t splitmix(uint64_t *state)
+{
+    uint64_t z = (*state += 0x9e3779b97f4a7c15ULL);
+
+
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+
+/*
+ * Function:    uniform
+ *
+ * Complexity:  O(1)
+ *
+ * Description: Return a uniformly distributed double in [0, 1) from the
+ *		generator whose state is pointed to by STATE.
+ */
+
+static double uniform(uint64_t *state)
+{
+    return (splitmix(state) >> 11) * 0x1.0p-53;
+}
+
+
+/*
+ * Functions:   helper1, helper2
+ *
+ * Complexity:  O(1)
+ *
+ * Description: Return log(1 + x) / x and (exp(x) - 1) / x, using their
+ *		Taylor series near zero where the division loses precision.
+ */
+
+static double helper1(double x)
+{
+    if (fabs(x) > 1e-8)
+	return log1p(x) / x;
+
+    return 1 - x * (0.5 - x * (1.0 / 3 - 0.25 * x));
+}
+
+static double helper2(double x)
+{
+    if (fabs(x) > 1e-8)
+	return expm1(x) / x;
+
+    return 1 + x * 0.5 * (1 + x * (1.0 / 3) * (1 + 0.25 * x));
+}
+
+
+/*
+ * Functions:   h, hIntegral, hIntegralInverse
+ *
+ * Complexity:  O(1)
+ *
+ * Description: The hat function 1 / x^s that bounds the probabilities of
+ *		the ranks, its integral, and the inverse of its integral.
+ */
+
+static double h(double x)
+{
+    return exp(-exponent * log(x));
+}
+
+static double hIntegral(double x)
+{
+    double logx = log(x);
+
+
+    return helper2((1 - exponent) * logx) * logx;
+}
+
+static double hIntegralInverse(double x)
+{
+    double t = x * (1 - exponent);
+
+
+    if (t < -1)
+	t = -1;
+
+    return exp(helper1(t) * x);
+}
+
+
+/*
+ * Function:    setup
+ *
+ * Complexity:  O(1)
+ *
+ * Description: Compute the constants for drawing ranks from a vocabulary
+ *		of N words and for spelling them out.
+ */
+
+static void setup(uint64_t n)
+{
+    int length;
+    uint64_t state = seed;
+
+
+    hX1 = hIntegral(1.5) - 1;
+    hN = hIntegral(n + 0.5);
+    squeeze = 2 - hIntegralInverse(hIntegral(2.5) - h(2));
+
+    /* A multiplier is a bijection mod 26^length as long as it is prime to
+       26, meaning it is odd and not a multiple of 13. */
+
+    power[0] = 1;
+
+    for (length = 1; length <= MAX_LENGTH; length ++) {
+	power[length] = power[length - 1] * 26;
+	multiplier[length] = (splitmix(&state) % power[length]) | 1;
+
+	while (multiplier[length] % 13 == 0)
+	    multiplier[length] = (multiplier[length] + 2) % power[length];
+
+	offset[length] = splitmix(&state) % power[length];
+    }
+}
+
+
+/*
+ * Function:    drawRank
+ *
+ * Complexity:  O(1) expected
+ *
+ * Description: Return a rank between 1 and N drawn from the Zipf
+ *		distribution, using the generator whose state is pointed to
+ *		by STATE.
+ */
+
+static uint64_t drawRank(uint64_t *state, uint64_t n)
+{
+    double u, x;
+    uint64_t k;
+
+
+    while (1) {
+	u = hN + uniform(state) * (hX1 - hN);
+	x = hIntegralInverse(u);
+	k = x + 0.5;
+
+	if (k < 1)
+	    k = 1;
+	else if (k > n)
+	    k = n;
+
+	if (k - x <= squeeze || u >= hIntegral(k + 0.5) - h(k))
+	    return k;
+    }
+}
+
+
+/*
+ * Function:    spell
+ *
+ * Complexity:  O(m) where m is the maximum length
+ *
+ * Description: Write the word of rank K into WORD and return its length.
+ *		The length is drawn from 1 + Poisson(MEAN - 1), but is at
+ *		least enough for 26^length to exceed K and at most MAX.
+ */
+
+static int spell(uint64_t k, double mean, int max, char *word)
+{
+    uint64_t state, value;
+    double limit, product;
+    int i, length;
+
+
+    /* Knuth's method: count the uniforms it takes for their product to
+       fall below exp(-(mean - 1)). */
+
+    state = seed ^ (k * 0xd1342543de82ef95ULL);
+    limit = exp(-(mean - 1));
+    product = uniform(&state);
+
+    for (length = 1; product > limit && length < max; length ++)
+	product *= uniform(&state);
+
+    while (length < max && power[length] <= k)
+	length ++;
+
+    value = ((unsigned __int128) multiplier[length] * (k - 1) + offset[length]) % power[length];
+
+    for (i = length - 1; i >= 0; i --) {
+	word[i] = 'a' + value % 26;
+	value /= 26;
+    }
+
+    return length;
+}
+
+
+/*
+ * Function:    main
+ *
+ * Description: Driver function for the generator.
+ */
+
+int main(int argc, char *argv[])
+{
+    char word[MAX_LENGTH + 1];
+    uint64_t i, words = 1000000, vocabulary = 100000, state;
+    double mean = 5;
+    int length, max = MAX_LENGTH;
+
+
+    /* Check usage. */
+
+    while (argc > 2 && argv[1][0] == '-' && strlen(argv[1]) == 2) {
+	switch (argv[1][1]) {
+	case 'n':
+	    words = strtoull(argv[2], NULL, 10);
+	    break;
+
+	case 'v':
+	    vocabulary = strtoull(argv[2], NULL, 10);
+	    break;
+
+	case 's':
+	    exponent = atof(argv[2]);
+	    break;
+
+	case 'm':
+	    mean = atof(argv[2]);
+	    break;
+
+	case 'x':
+	    max = atoi(argv[2]);
+	    break;
+
+	case 'r':
+	    seed = strtoull(argv[2], NULL, 10);
+	    break;
+
+	default:
+	    argc = 0;
+	    break;
+	}
+
+	if (argc == 0)
+	    break;
+
+	argc -= 2;
+	argv += 2;
+    }
+
+    if (argc != 1 || vocabulary < 1 || exponent < 0 || mean < 1 ||
+	    max < 1 || max > MAX_LENGTH) {
+	fprintf(stderr, "usage: zipf [-n words] [-v vocabulary] [-s exponent] "
+	    "[-m mean-length] [-x max-length] [-r seed]\n");
+	exit(EXIT_FAILURE);
+    }
+
+    setup(vocabulary);
+
+    if (vocabulary > power[max]) {
+	fprintf(stderr, "zipf: a vocabulary of %llu needs a max length above %d\n",
+	    (unsigned long long) vocabulary, max);
+	exit(EXIT_FAILURE);
+    }
+
+
+    /* Write the words. */
+
+    state = seed ^ 0x5851f42d4c957f2dULL;
+
+    for (i = 0; i < words; i ++) {
+	length = spell(drawRank(&state, vocabulary), mean, max, word);
+	fwrite(word, 1, length, stdout);
+	putchar((i + 1) % LINE_WORDS == 0 || i + 1 == words ? '\n' : ' ');
+    }
+
+    exit(EXIT_SUCCESS);
+}
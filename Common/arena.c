@@ -0,0 +1,266 @@
+/*
+ * File:        arena.c
+ *
+ * Description: This file contains the public and private function and type
+ *              definitions for an arena of strings.
+ *
+ *              Strings are bumped off the end of the current chunk, so
+ *              consecutive copies sit next to each other in memory with no
+ *              allocator header between them.  When a chunk fills up, a new
+ *              one twice as large is started, up to MAX_CHUNK, so the
+ *              number of chunks, and so the cost of destroying the arena,
+ *              stays small.  A string too long for a chunk of the current
+ *              size gets a chunk of its own.
+ *
+ *              Interned strings are found with an open-addressed hash
+ *              table of the copies made so far, using linear probing.  The
+ *              hash of each copy is kept next to it in the table so that
+ *              most mismatches are rejected without touching the string.
+ */
+
+# include <stdlib.h>
+# include <string.h>
+# include <assert.h>
+# include <stdbool.h>
+# include "arena.h"
+
+# define MIN_CHUNK (1 << 14)
+# define MAX_CHUNK (1 << 20)
+# define MIN_SLOTS 1024
+
+typedef struct chunk {
+    struct chunk *next;         /* chunk allocated before this one */
+    char data[];                /* strings copied into the chunk   */
+} CHUNK;
+
+struct arena {
+    CHUNK *chunks;              /* most recently allocated chunk   */
+    char *next;                 /* free space in current chunk     */
+    char *end;                  /* end of current chunk            */
+    int size;                   /* size of the next chunk          */
+    bool intern;                /* share copies of equal strings   */
+    char **slots;               /* hash table of interned copies   */
+    unsigned *hashes;           /* hashes of those copies          */
+    int length;                 /* number of slots in table        */
+    int count;                  /* number of copies in table       */
+};
+
+
+/*
+ * Function:    hashString
+ *
+ * Complexity:  O(n) where n is the length of the string
+ *
+ * Description: Return the 32-bit FNV-1a hash of the string STRING of the
+ *		given LENGTH.
+ */
+
+static unsigned hashString(char *string, int length)
+{
+    unsigned hash = 2166136261u;
+    int i;
+
+
+    for (i = 0; i < length; i ++)
+	hash = (hash ^ (unsigned char) string[i]) * 16777619u;
+
+    return hash;
+}
+
+
+/*
+ * Function:    addChunk
+ *
+ * Complexity:  O(1)
+ *
+ * Description: Allocate a new chunk with room for at least SIZE bytes in
+ *		the arena pointed to by AP and return a pointer to its
+ *		space.  A chunk larger than the usual size is only used for
+ *		the one string it was made for, so the current chunk is kept
+ *		for the strings after it.
+ */
+
+static char *addChunk(ARENA *ap, int size)
+{
+    CHUNK *cp;
+
+
+    if (size > ap->size) {
+	cp = malloc(sizeof(CHUNK) + size);
+	assert(cp != NULL);
+
+	if (ap->chunks != NULL) {
+	    cp->next = ap->chunks->next;
+	    ap->chunks->next = cp;
+	} else {
+	    cp->next = NULL;
+	    ap->chunks = cp;
+	    ap->next = ap->end = cp->data + size;
+	}
+
+	return cp->data;
+    }
+
+    cp = malloc(sizeof(CHUNK) + ap->size);
+    assert(cp != NULL);
+
+    cp->next = ap->chunks;
+    ap->chunks = cp;
+    ap->next = cp->data + size;
+    ap->end = cp->data + ap->size;
+
+    if (ap->size < MAX_CHUNK)
+	ap->size *= 2;
+
+    return cp->data;
+}
+
+
+/*
+ * Function:    growTable
+ *
+ * Complexity:  O(n)
+ *
+ * Description: Double the number of slots in the hash table of the arena
+ *		pointed to by AP and reinsert the copies it holds.
+ */
+
+static void growTable(ARENA *ap)
+{
+    char **slots = ap->slots;
+    unsigned *hashes = ap->hashes;
+    int i, j, length = ap->length;
+
+
+    ap->length = length > 0 ? length * 2 : MIN_SLOTS;
+    ap->slots = calloc(ap->length, sizeof(char *));
+    ap->hashes = malloc(sizeof(unsigned) * ap->length);
+    assert(ap->slots != NULL && ap->hashes != NULL);
+
+    for (i = 0; i < length; i ++)
+	if (slots[i] != NULL) {
+	    j = hashes[i] & (ap->length - 1);
+
+	    while (ap->slots[j] != NULL)
+		j = (j + 1) & (ap->length - 1);
+
+	    ap->slots[j] = slots[i];
+	    ap->hashes[j] = hashes[i];
+	}
+
+    free(slots);
+    free(hashes);
+}
+
+
+/*
+ * Function:    createArena
+ *
+ * Complexity:  O(1)
+ *
+ * Description: Return a pointer to a new empty arena, which interns the
+ *		strings copied into it if INTERN is true.  No chunk is
+ *		allocated until the first string is copied.
+ */
+
+ARENA *createArena(bool intern)
+{
+    ARENA *ap;
+
+
+    ap = malloc(sizeof(ARENA));
+    assert(ap != NULL);
+
+    ap->chunks = NULL;
+    ap->next = ap->end = NULL;
+    ap->size = MIN_CHUNK;
+    ap->intern = intern;
+    ap->slots = NULL;
+    ap->hashes = NULL;
+    ap->length = 0;
+    ap->count = 0;
+    return ap;
+}
+
+
+/*
+ * Function:    destroyArena
+ *
+ * Complexity:  O(m) where m is the number of chunks
+ *
+ * Description: Deallocate the arena pointed to by AP along with every
+ *		string that was copied into it.
+ */
+
+void destroyArena(ARENA *ap)
+{
+    CHUNK *cp, *next;
+
+
+    assert(ap != NULL);
+
+    for (cp = ap->chunks; cp != NULL; cp = next) {
+	next = cp->next;
+	free(cp);
+    }
+
+    free(ap->slots);
+    free(ap->hashes);
+    free(ap);
+}
+
+
+/*
+ * Function:    copyArena
+ *
+ * Complexity:  O(n) where n is the length of the string, on average
+ *
+ * Description: Return a null-terminated copy of the string STRING of the
+ *		given LENGTH in the arena pointed to by AP.  If the arena
+ *		interns its strings and already holds a copy of STRING, that
+ *		copy is returned instead.  STRING itself need not be null-
+ *		terminated.  The copy is valid until the arena is destroyed.
+ */
+
+char *copyArena(ARENA *ap, char *string, int length)
+{
+    unsigned hash = 0;
+    int i = 0;
+    char *copy;
+
+
+    assert(ap != NULL && string != NULL && length >= 0);
+
+    if (ap->intern) {
+	if (2 * (ap->count + 1) > ap->length)
+	    growTable(ap);
+
+	hash = hashString(string, length);
+	i = hash & (ap->length - 1);
+
+	while (ap->slots[i] != NULL) {
+	    if (ap->hashes[i] == hash && strncmp(ap->slots[i], string, length) == 0
+		    && ap->slots[i][length] == '\0')
+		return ap->slots[i];
+
+	    i = (i + 1) & (ap->length - 1);
+	}
+    }
+
+    if (ap->end - ap->next > length) {
+	copy = ap->next;
+	ap->next += length + 1;
+    } else
+	copy = addChunk(ap, length + 1);
+
+    memcpy(copy, string, length);
+    copy[length] = '\0';
+
+    if (ap->intern) {
+	ap->slots[i] = copy;
+	ap->hashes[i] = hash;
+	ap->count ++;
+    }
+
+    return copy;
+}
@@ -0,0 +1,30 @@
+/*
+ * File:        arena.h
+ *
+ * Description: This file contains the public function and type
+ *              declarations for an arena of strings.  Strings copied into
+ *              an arena are packed one after another into large chunks
+ *              instead of each being allocated on its own, and are all
+ *              deallocated at once when the arena is destroyed.  A single
+ *              string cannot be deallocated by itself.
+ *
+ *              If interning is turned on when the arena is created, copying
+ *              a string that is already in the arena returns the copy that
+ *              is already there instead of making another, so that equal
+ *              strings share the same storage.
+ */
+
+# ifndef ARENA_H
+# define ARENA_H
+
+# include <stdbool.h>
+
+typedef struct arena ARENA;
+
+extern ARENA *createArena(bool intern);
+
+extern void destroyArena(ARENA *ap);
+
+extern char *copyArena(ARENA *ap, char *string, int length);
+
+# endif /* ARENA_H */
@@ -0,0 +1,323 @@
+/*
+ * File:        hash.c
+ *
+ * Description: This file contains the public and private function
+ *              definitions for a collection of string hash functions.
+ *
+ *              Words are read with memcpy so that a string at any address
+ *              can be hashed, and the compiler turns each memcpy into a
+ *              single load.  Short strings are read as two overlapping
+ *              words instead of byte by byte, so that most English words
+ *              take only a few instructions to hash.
+ *
+ *              The SSE4.2 crc32 instruction is used by hashCrc only if the
+ *              processor it runs on has it, which is checked the first time
+ *              it is called, so the program does not have to be compiled
+ *              with -msse4.2 to use it.
+ */
+
+# include <string.h>
+# include <stdint.h>
+# include "hash.h"
+# if defined(__GNUC__) && defined(__x86_64__)
+# include <nmmintrin.h>
+# define HAVE_CRC32
+# endif
+
+# define WIDE_0 0xa0761d6478bd642full
+# define WIDE_1 0xe7037ed1a0b428dbull
+# define CRC_POLY 0x82f63b78u
+
+
+/*
+ * Function:    read8
+ *
+ * Description: Return the 8 bytes starting at P as an integer.
+ */
+
+static inline uint64_t read8(char *p)
+{
+    uint64_t v;
+
+
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+
+/*
+ * Function:    read4
+ *
+ * Description: Return the 4 bytes starting at P as an integer.
+ */
+
+static inline uint64_t read4(char *p)
+{
+    uint32_t v;
+
+
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+
+/*
+ * Function:    mix
+ *
+ * Description: Return the full 128-bit product of A and B folded to 64
+ *		bits, so that every bit of each depends on every bit of the
+ *		other.
+ */
+
+static inline uint64_t mix(uint64_t a, uint64_t b)
+{
+    __uint128_t r = (__uint128_t) a * b;
+
+
+    return (uint64_t) r ^ (uint64_t) (r >> 64);
+}
+
+
+/*
+ * Function:    hashMultiply
+ *
+ * Complexity:  O(n) where n is the length of the string
+ *
+ * Description: Return 31 * hash + c over the bytes of STRING of the given
+ *		LENGTH, which is the same value strhash gives.
+ */
+
+unsigned hashMultiply(char *string, int length)
+{
+    unsigned hash = 0;
+    char *end = string + length;
+
+
+    while (string < end)
+	hash = 31 * hash + *string ++;
+
+    return hash;
+}
+
+
+/*
+ * Function:    hashWide
+ *
+ * Complexity:  O(n) where n is the length of the string
+ *
+ * Description: Return a hash of STRING of the given LENGTH, which is
+ *		read 16 bytes at a time.  The last 16 bytes, or the whole
+ *		string if it is shorter, are read as two words that may
+ *		overlap, and mixed with the length and the state left by
+ *		the longer part.
+ */
+
+unsigned hashWide(char *string, int length)
+{
+    uint64_t seed = WIDE_0, a, b, hash;
+    char *p = string;
+    int i = length;
+
+
+    if (length <= 16) {
+	if (length >= 4) {
+	    a = read4(p) << 32 | read4(p + ((length >> 3) << 2));
+	    b = read4(p + length - 4) << 32 |
+		read4(p + length - 4 - ((length >> 3) << 2));
+	} else if (length > 0) {
+	    a = (uint64_t) (unsigned char) p[0] << 16 |
+		(uint64_t) (unsigned char) p[length >> 1] << 8 |
+		(unsigned char) p[length - 1];
+	    b = 0;
+	} else
+	    a = b = 0;
+    } else {
+	while (i > 16) {
+	    seed = mix(read8(p) ^ WIDE_1, read8(p + 8) ^ seed);
+	    p += 16;
+	    i -= 16;
+	}
+
+	a = read8(p + i - 16);
+	b = read8(p + i - 8);
+    }
+
+    hash = mix(WIDE_1 ^ length, mix(a ^ WIDE_1, b ^ seed));
+    return (unsigned) (hash ^ hash >> 32);
+}
+
+
+/*
+ * Function:    crcTable
+ *
+ * Complexity:  O(1)
+ *
+ * Description: Return the table of the CRC32C of each byte value, which
+ *		is filled in the first time it is needed.
+ */
+
+static uint32_t *crcTable(void)
+{
+    static uint32_t table[256];
+    static int filled = 0;
+    uint32_t crc;
+    int i, j;
+
+
+    if (!filled) {
+	for (i = 0; i < 256; i ++) {
+	    crc = i;
+
+	    for (j = 0; j < 8; j ++)
+		crc = crc & 1 ? (crc >> 1) ^ CRC_POLY : crc >> 1;
+
+	    table[i] = crc;
+	}
+
+	filled = 1;
+    }
+
+    return table;
+}
+
+
+/*
+ * Function:    crcSoftware
+ *
+ * Complexity:  O(n) where n is the length of the string
+ *
+ * Description: Return the CRC32C checksum of STRING of the given LENGTH,
+ *		found a byte at a time with a table.
+ */
+
+static unsigned crcSoftware(char *string, int length)
+{
+    char *end = string + length;
+    uint32_t *table = crcTable(), crc = 0xffffffffu;
+
+
+    while (string < end)
+	crc = (crc >> 8) ^ table[(crc ^ (unsigned char) *string ++) & 0xff];
+
+    return crc ^ 0xffffffffu;
+}
+
+
+# ifdef HAVE_CRC32
+
+/*
+ * Function:    crcHardware
+ *
+ * Complexity:  O(n) where n is the length of the string
+ *
+ * Description: Return the CRC32C checksum of STRING of the given LENGTH
+ *		using the SSE4.2 crc32 instruction.  The string is read 8
+ *		bytes at a time and the rest 4, 2, and then 1 byte at a
+ *		time.  This is compiled for SSE4.2 whatever the flags given
+ *		to the compiler, so it must only be called if the processor
+ *		has it.
+ */
+
+__attribute__((target("sse4.2")))
+static unsigned crcHardware(char *string, int length)
+{
+    char *end = string + length;
+    uint64_t crc = 0xffffffffu;
+
+
+    while (end - string >= 8) {
+	crc = _mm_crc32_u64(crc, read8(string));
+	string += 8;
+    }
+
+    if (end - string >= 4) {
+	crc = _mm_crc32_u32(crc, read4(string));
+	string += 4;
+    }
+
+    if (end - string >= 2) {
+	uint16_t v;
+
+	memcpy(&v, string, sizeof(v));
+	crc = _mm_crc32_u16(crc, v);
+	string += 2;
+    }
+
+    if (string < end)
+	crc = _mm_crc32_u8(crc, *string);
+
+    return (unsigned) crc ^ 0xffffffffu;
+}
+
+# endif
+
+
+/*
+ * Function:    chooseCrc
+ *
+ * Complexity:  O(1)
+ *
+ * Description: Return crcHardware if the processor has SSE4.2, and
+ *		crcSoftware otherwise.  The choice is made once and then
+ *		remembered.
+ */
+
+static HASHFUNC *chooseCrc(void)
+{
+    static HASHFUNC *crc = NULL;
+
+
+    if (crc == NULL) {
+	crc = crcSoftware;
+# ifdef HAVE_CRC32
+	__builtin_cpu_init();
+
+	if (__builtin_cpu_supports("sse4.2"))
+	    crc = crcHardware;
+# endif
+    }
+
+    return crc;
+}
+
+
+/*
+ * Function:    hashCrc
+ *
+ * Complexity:  O(n) where n is the length of the string
+ *
+ * Description: Return the CRC32C checksum of STRING of the given LENGTH,
+ *		using the crc32 instruction if the processor has SSE4.2 and a
+ *		table otherwise.
+ */
+
+unsigned hashCrc(char *string, int length)
+{
+    return (*chooseCrc())(string, length);
+}
+
+
+/*
+ * Function:    findHash
+ *
+ * Complexity:  O(1)
+ *
+ * Description: Return the hash function called NAME, which is one of
+ *		"multiply", "wide", or "crc", or NULL if there is none.  For
+ *		"crc", the version of hashCrc chosen for this processor is
+ *		returned, so that calls through it skip the choice.
+ */
+
+HASHFUNC *findHash(char *name)
+{
+    if (strcmp(name, "multiply") == 0)
+	return hashMultiply;
+
+    if (strcmp(name, "wide") == 0)
+	return hashWide;
+
+    if (strcmp(name, "crc") == 0)
+	return chooseCrc();
+
+    return NULL;
+}
@@ -0,0 +1,31 @@
+/*
+ * File:        hash.h
+ *
+ * Description: This file contains the public function and type
+ *              declarations for a collection of string hash functions.
+ *              Each one hashes a string of a given length, which need not
+ *              be null-terminated, to an unsigned value, and can be passed
+ *              to a set when it is created.
+ *
+ *              hashMultiply is the usual 31 * hash + c hash, which reads one
+ *              byte at a time.  hashWide reads 8 bytes at a time and mixes
+ *              them with 64-bit multiplies in the style of wyhash.  hashCrc
+ *              is the CRC32C checksum of the string, which is computed 8
+ *              bytes at a time with the SSE4.2 crc32 instruction when the
+ *              processor has it, and with a table otherwise.
+ */
+
+# ifndef HASH_H
+# define HASH_H
+
+typedef unsigned HASHFUNC(char *string, int length);
+
+extern unsigned hashMultiply(char *string, int length);
+
+extern unsigned hashWide(char *string, int length);
+
+extern unsigned hashCrc(char *string, int length);
+
+extern HASHFUNC *findHash(char *name);
+
+# endif /* HASH_H */
@@ -0,0 +1,407 @@
+/*
+ * File:        pipeline.c
+ *
+ * Description: This file contains the public and private function and type
+ *              definitions for a pipelined tokenizer.
+ *
+ *              A fixed pool of batches is passed around three bounded
+ *              rings.  The reader thread takes an empty batch, fills its
+ *              block from the file, and puts it on the full ring.  The
+ *              splitter thread takes a full batch, splits its block into
+ *              words, and puts it on the split ring.  The caller takes
+ *              words from a split batch until it runs out and then returns
+ *              the batch to the empty ring.  Since there are only BATCHES
+ *              batches, the reader can never get more than that far ahead
+ *              of the caller, and nothing is allocated once the pipeline
+ *              is running.
+ *
+ *              Every block ends at whitespace so that no word is split
+ *              across two batches.  The partial word at the end of what was
+ *              read is carried over to the front of the next block instead.
+ */
+
+# include <stdio.h>
+# include <stdlib.h>
+# include <string.h>
+# include <assert.h>
+# include <stdbool.h>
+# include <fcntl.h>
+# include <unistd.h>
+# include <pthread.h>
+# include "token.h"
+# include "pipeline.h"
+
+# define BLOCK_SIZE (1 << 17)
+# define BATCHES 8
+
+typedef struct batch {
+    char *buf;                  /* block of text from the file   */
+    int size;                   /* allocated size of block       */
+    int length;                 /* number of bytes in block      */
+    char **words;               /* words found in block          */
+    int *lengths;               /* lengths of those words        */
+    int count;                  /* number of words found         */
+} BATCH;
+
+typedef struct ring {
+    BATCH *slots[BATCHES];      /* batches waiting in the ring   */
+    int head;                   /* slot of the oldest batch      */
+    int count;                  /* number of batches waiting     */
+    bool closed;                /* true once no more will come   */
+    pthread_mutex_t lock;
+    pthread_cond_t ready;
+} RING;
+
+struct pipeline {
+    int fd;                     /* file being read               */
+    bool fold;                  /* lowercase and trim words      */
+    BATCH batches[BATCHES];     /* pool of batches               */
+    RING empty;                 /* batches waiting to be read    */
+    RING full;                  /* batches waiting to be split   */
+    RING split;                 /* batches waiting to be used    */
+    pthread_t reader;
+    pthread_t splitter;
+    BATCH *current;             /* batch words are taken from    */
+    int next;                   /* next word in current batch    */
+};
+
+
+/*
+ * Function:    isSpace
+ *
+ * Complexity:  O(1)
+ *
+ * Description: Return whether C is one of the whitespace characters that
+ *		separate words for "%s": space, \t, \n, \v, \f, and \r.
+ */
+
+static inline bool isSpace(unsigned char c)
+{
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+
+/*
+ * Function:    initRing
+ *
+ * Complexity:  O(1)
+ *
+ * Description: Initialize the ring pointed to by RP to be empty.
+ */
+
+static void initRing(RING *rp)
+{
+    rp->head = 0;
+    rp->count = 0;
+    rp->closed = false;
+    pthread_mutex_init(&rp->lock, NULL);
+    pthread_cond_init(&rp->ready, NULL);
+}
+
+
+/*
+ * Function:    putRing
+ *
+ * Complexity:  O(1)
+ *
+ * Description: Add the batch pointed to by BP to the end of the ring
+ *		pointed to by RP.  A ring has room for every batch in the
+ *		pool, so this never has to wait.
+ */
+
+static void putRing(RING *rp, BATCH *bp)
+{
+    pthread_mutex_lock(&rp->lock);
+    assert(rp->count < BATCHES);
+
+    rp->slots[(rp->head + rp->count ++) % BATCHES] = bp;
+    pthread_cond_signal(&rp->ready);
+    pthread_mutex_unlock(&rp->lock);
+}
+
+
+/*
+ * Function:    getRing
+ *
+ * Complexity:  O(1)
+ *
+ * Description: Remove and return the batch at the front of the ring
+ *		pointed to by RP, waiting for one if the ring is empty, or
+ *		return NULL if the ring is empty and has been closed.
+ */
+
+static BATCH *getRing(RING *rp)
+{
+    BATCH *bp = NULL;
+
+
+    pthread_mutex_lock(&rp->lock);
+
+    while (rp->count == 0 && !rp->closed)
+	pthread_cond_wait(&rp->ready, &rp->lock);
+
+    if (rp->count > 0) {
+	bp = rp->slots[rp->head];
+	rp->head = (rp->head + 1) % BATCHES;
+	rp->count --;
+    }
+
+    pthread_mutex_unlock(&rp->lock);
+    return bp;
+}
+
+
+/*
+ * Function:    closeRing
+ *
+ * Complexity:  O(1)
+ *
+ * Description: Close the ring pointed to by RP so that getRing returns
+ *		NULL once it is empty.  If DISCARD is true, any batches
+ *		still waiting in the ring are dropped so that it returns
+ *		NULL right away.
+ */
+
+static void closeRing(RING *rp, bool discard)
+{
+    pthread_mutex_lock(&rp->lock);
+
+    if (discard)
+	rp->count = 0;
+
+    rp->closed = true;
+    pthread_cond_broadcast(&rp->ready);
+    pthread_mutex_unlock(&rp->lock);
+}
+
+
+/*
+ * Function:    growBatch
+ *
+ * Complexity:  O(n)
+ *
+ * Description: Make the block of the batch pointed to by BP hold SIZE
+ *		bytes, and its arrays hold as many words as a block of that
+ *		size can have.
+ */
+
+static void growBatch(BATCH *bp, int size)
+{
+    bp->size = size;
+    bp->buf = realloc(bp->buf, size + TOKEN_PADDING);
+    bp->words = realloc(bp->words, sizeof(char *) * (size / 2 + 1));
+    bp->lengths = realloc(bp->lengths, sizeof(int) * (size / 2 + 1));
+    assert(bp->buf != NULL && bp->words != NULL && bp->lengths != NULL);
+}
+
+
+/*
+ * Function:    readBlocks
+ *
+ * Complexity:  O(n) where n is the size of the file
+ *
+ * Description: Body of the reader thread for the pipeline pointed to by
+ *		ARG.  Fill each empty batch with a block of the file that
+ *		ends at whitespace, carrying the partial word at its end over
+ *		to the next block, until the file is read or the pipeline is
+ *		closed.
+ */
+
+static void *readBlocks(void *arg)
+{
+    PIPELINE *pp = arg;
+    BATCH *bp;
+    char *carry = NULL;
+    int n, cut, ncarry = 0;
+    bool eof = false;
+
+
+    while (!eof && (bp = getRing(&pp->empty)) != NULL) {
+	if (ncarry >= bp->size)
+	    growBatch(bp, bp->size * 2 > ncarry ? bp->size * 2 : ncarry * 2);
+
+	if (ncarry > 0)
+	    memcpy(bp->buf, carry, ncarry);
+
+	bp->length = ncarry;
+
+	/* Fill the block, and grow it if all of it is a single word. */
+
+	while (true) {
+	    while (bp->length < bp->size &&
+		    (n = read(pp->fd, bp->buf + bp->length, bp->size - bp->length)) > 0)
+		bp->length += n;
+
+	    if (bp->length < bp->size) {
+		eof = true;
+		cut = bp->length;
+		break;
+	    }
+
+	    for (cut = bp->length; cut > 0 && !isSpace(bp->buf[cut - 1]); cut --)
+		;
+
+	    if (cut > 0)
+		break;
+
+	    growBatch(bp, bp->size * 2);
+	}
+
+	ncarry = bp->length - cut;
+	carry = realloc(carry, ncarry + 1);
+	assert(carry != NULL);
+	memcpy(carry, bp->buf + cut, ncarry);
+
+	bp->length = cut;
+	putRing(&pp->full, bp);
+    }
+
+    free(carry);
+    closeRing(&pp->full, false);
+    return NULL;
+}
+
+
+/*
+ * Function:    splitBlocks
+ *
+ * Complexity:  O(n) where n is the size of the file
+ *
+ * Description: Body of the splitter thread for the pipeline pointed to by
+ *		ARG.  Split the block of each full batch into words until
+ *		the reader is done.
+ */
+
+static void *splitBlocks(void *arg)
+{
+    PIPELINE *pp = arg;
+    BATCH *bp;
+
+
+    while ((bp = getRing(&pp->full)) != NULL) {
+	bp->count = splitTokens(bp->buf, bp->length, pp->fold, bp->words, bp->lengths);
+	putRing(&pp->split, bp);
+    }
+
+    closeRing(&pp->split, false);
+    return NULL;
+}
+
+
+/*
+ * Function:    openPipeline
+ *
+ * Complexity:  O(1)
+ *
+ * Description: Return a pointer to a new pipeline for the file named
+ *		FILENAME, whose words are folded as by foldTokens if FOLD is
+ *		true, or NULL if the file cannot be opened.  The reader and
+ *		splitter threads start right away.
+ */
+
+PIPELINE *openPipeline(char *filename, bool fold)
+{
+    PIPELINE *pp;
+    int i, fd;
+
+
+    assert(filename != NULL);
+
+    if ((fd = open(filename, O_RDONLY)) < 0)
+	return NULL;
+
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    pp = malloc(sizeof(PIPELINE));
+    assert(pp != NULL);
+
+    pp->fd = fd;
+    pp->fold = fold;
+    pp->current = NULL;
+    pp->next = 0;
+
+    initRing(&pp->empty);
+    initRing(&pp->full);
+    initRing(&pp->split);
+
+    for (i = 0; i < BATCHES; i ++) {
+	pp->batches[i].buf = NULL;
+	pp->batches[i].words = NULL;
+	pp->batches[i].lengths = NULL;
+	growBatch(&pp->batches[i], BLOCK_SIZE);
+	putRing(&pp->empty, &pp->batches[i]);
+    }
+
+    if (pthread_create(&pp->reader, NULL, readBlocks, pp) != 0 ||
+	    pthread_create(&pp->splitter, NULL, splitBlocks, pp) != 0) {
+	fprintf(stderr, "cannot create pipeline threads\n");
+	exit(EXIT_FAILURE);
+    }
+
+    return pp;
+}
+
+
+/*
+ * Function:    closePipeline
+ *
+ * Complexity:  O(1)
+ *
+ * Description: Stop the threads of the pipeline pointed to by PP, close
+ *		its file, and deallocate its memory.  The rest of the file
+ *		is not read if the pipeline is closed early.
+ */
+
+void closePipeline(PIPELINE *pp)
+{
+    int i;
+
+
+    assert(pp != NULL);
+
+    /* With no empty batches left, the reader stops after its current
+       block and the splitter follows once it has split it. */
+
+    closeRing(&pp->empty, true);
+    pthread_join(pp->reader, NULL);
+    pthread_join(pp->splitter, NULL);
+
+    for (i = 0; i < BATCHES; i ++) {
+	free(pp->batches[i].buf);
+	free(pp->batches[i].words);
+	free(pp->batches[i].lengths);
+    }
+
+    close(pp->fd);
+    free(pp);
+}
+
+
+/*
+ * Function:    nextWord
+ *
+ * Complexity:  O(1)
+ *
+ * Description: Return the next word in the file of the pipeline pointed
+ *		to by PP and store its length in *LENGTH, or return NULL at
+ *		the end of the file.  The word is only valid until the next
+ *		call, so it must be copied if it is to be kept.
+ */
+
+char *nextWord(PIPELINE *pp, int *length)
+{
+    assert(pp != NULL && length != NULL);
+
+    while (pp->current == NULL || pp->next == pp->current->count) {
+	if (pp->current != NULL)
+	    putRing(&pp->empty, pp->current);
+
+	if ((pp->current = getRing(&pp->split)) == NULL)
+	    return NULL;
+
+	pp->next = 0;
+    }
+
+    *length = pp->current->lengths[pp->next];
+    return pp->current->words[pp->next ++];
+}
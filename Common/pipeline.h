@@ -0,0 +1,29 @@
+/*
+ * File:        pipeline.h
+ *
+ * Description: This file contains the public function and type
+ *              declarations for a pipelined tokenizer.  A reader thread
+ *              reads the file in large blocks, a tokenizer thread splits
+ *              each block into a batch of words, and the caller takes the
+ *              words one at a time, so that reading and splitting the file
+ *              overlap with whatever the caller does with each word.
+ *
+ *              Words are returned exactly as by nextToken, as null-
+ *              terminated views that are only valid until the next call to
+ *              nextWord.
+ */
+
+# ifndef PIPELINE_H
+# define PIPELINE_H
+
+# include <stdbool.h>
+
+typedef struct pipeline PIPELINE;
+
+extern PIPELINE *openPipeline(char *filename, bool fold);
+
+extern void closePipeline(PIPELINE *pp);
+
+extern char *nextWord(PIPELINE *pp, int *length);
+
+# endif /* PIPELINE_H */
@@ -0,0 +1,478 @@
+/*
+ * File:        token.c
+ *
+ * Description: This file contains the public and private function and type
+ *              definitions for a tokenizer of whitespace-separated words.
+ *
+ *              The file is read in large blocks into a single buffer and
+ *              words are found in place.  The whitespace byte that ends a
+ *              word is overwritten with a null byte, so every word handed
+ *              out is already a C string and nothing is copied.  A word
+ *              that is cut off by the end of the buffer is moved to the
+ *              front of the buffer before the next block is read after it.
+ *
+ *              The buffer is always followed by PADDING bytes of spaces,
+ *              so it can be scanned 16 bytes at a time with SSE2 without
+ *              checking for its end on every load.  If folding is turned
+ *              on, the same scan also lowercases ASCII letters in place
+ *              and finds the first and last bytes of the word that are
+ *              not punctuation, so that "The", "the", and "the," are all
+ *              returned as "the" without a second pass over the word.
+ */
+
+# include <stdio.h>
+# include <stdlib.h>
+# include <string.h>
+# include <assert.h>
+# include <stdbool.h>
+# include <fcntl.h>
+# include <unistd.h>
+# include "token.h"
+
+# ifdef __SSE2__
+# include <emmintrin.h>
+# endif
+
+# define BLOCK_SIZE (1 << 20)
+# define PADDING TOKEN_PADDING
+
+struct tokenizer {
+    int fd;                     /* file being read             */
+    char *buf;                  /* buffer the file is read into */
+    int size;                   /* allocated size of buffer    */
+    int pos;                    /* next byte to be scanned     */
+    int end;                    /* number of bytes in buffer   */
+    bool eof;                   /* true once the file is read  */
+    bool fold;                  /* lowercase and trim words    */
+};
+
+
+/*
+ * Function:    isSpace
+ *
+ * Complexity:  O(1)
+ *
+ * Description: Return whether C is one of the whitespace characters that
+ *		separate words for "%s": space, \t, \n, \v, \f, and \r.
+ */
+
+static inline bool isSpace(unsigned char c)
+{
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+
+/*
+ * Function:    isPunct
+ *
+ * Complexity:  O(1)
+ *
+ * Description: Return whether C is an ASCII punctuation character, as in
+ *		ispunct() for the C locale.
+ */
+
+static inline bool isPunct(unsigned char c)
+{
+    return (c >= '!' && c <= '/') || (c >= ':' && c <= '@') ||
+	(c >= '[' && c <= '`') || (c >= '{' && c <= '~');
+}
+
+
+# ifdef __SSE2__
+/*
+ * Function:    inRange
+ *
+ * Complexity:  O(1)
+ *
+ * Description: Return a mask of the bytes of V that lie between LO and HI
+ *		inclusive.  Subtracting LO wraps the bytes below it around
+ *		to large values, so one unsigned comparison against HI - LO
+ *		checks both ends of the range.
+ */
+
+static inline __m128i inRange(__m128i v, char lo, char hi)
+{
+    __m128i t = _mm_sub_epi8(v, _mm_set1_epi8(lo));
+
+
+    return _mm_cmpeq_epi8(_mm_min_epu8(t, _mm_set1_epi8(hi - lo)), t);
+}
+
+
+/*
+ * Function:    spaceMask
+ *
+ * Complexity:  O(1)
+ *
+ * Description: Return a 16-bit mask of the whitespace bytes in V.
+ */
+
+static inline unsigned spaceMask(__m128i v)
+{
+    __m128i ws;
+
+
+    ws = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), inRange(v, '\t', '\r'));
+    return _mm_movemask_epi8(ws);
+}
+# endif
+
+
+/*
+ * Function:    refill
+ *
+ * Complexity:  O(n)
+ *
+ * Description: Keep the unscanned bytes of the buffer pointed to by TP,
+ *		moving them to the front, and read as much of the file as
+ *		fits after them.  The buffer is doubled if it is already
+ *		full of a single word.  Return false if nothing more could
+ *		be read.
+ */
+
+static bool refill(TOKENIZER *tp)
+{
+    int n;
+
+
+    if (tp->eof)
+	return false;
+
+    tp->end -= tp->pos;
+    memmove(tp->buf, tp->buf + tp->pos, tp->end);
+    tp->pos = 0;
+
+    if (tp->end == tp->size) {
+	tp->size *= 2;
+	tp->buf = realloc(tp->buf, tp->size + PADDING);
+	assert(tp->buf != NULL);
+    }
+
+    n = read(tp->fd, tp->buf + tp->end, tp->size - tp->end);
+
+    if (n > 0)
+	tp->end += n;
+    else
+	tp->eof = true;
+
+    memset(tp->buf + tp->end, ' ', PADDING);
+    return n > 0;
+}
+
+
+/*
+ * Function:    openTokenizer
+ *
+ * Complexity:  O(1)
+ *
+ * Description: Return a pointer to a new tokenizer for the file named
+ *		FILENAME, or NULL if the file cannot be opened.
+ */
+
+TOKENIZER *openTokenizer(char *filename)
+{
+    TOKENIZER *tp;
+    int fd;
+
+
+    assert(filename != NULL);
+
+    if ((fd = open(filename, O_RDONLY)) < 0)
+	return NULL;
+
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    tp = malloc(sizeof(TOKENIZER));
+    assert(tp != NULL);
+
+    tp->size = BLOCK_SIZE;
+    tp->buf = malloc(tp->size + PADDING);
+    assert(tp->buf != NULL);
+    memset(tp->buf, ' ', PADDING);
+
+    tp->fd = fd;
+    tp->pos = 0;
+    tp->end = 0;
+    tp->eof = false;
+    tp->fold = false;
+    return tp;
+}
+
+
+/*
+ * Function:    closeTokenizer
+ *
+ * Complexity:  O(1)
+ *
+ * Description: Close the file of the tokenizer pointed to by TP and
+ *		deallocate its memory.
+ */
+
+void closeTokenizer(TOKENIZER *tp)
+{
+    assert(tp != NULL);
+
+    close(tp->fd);
+    free(tp->buf);
+    free(tp);
+}
+
+
+/*
+ * Function:    foldTokens
+ *
+ * Complexity:  O(1)
+ *
+ * Description: Turn folding on or off for the tokenizer pointed to by TP.
+ *		While folding is on, words are lowercased and have their
+ *		leading and trailing punctuation removed, and words made up
+ *		of nothing but punctuation are skipped.
+ */
+
+void foldTokens(TOKENIZER *tp, bool fold)
+{
+    assert(tp != NULL);
+    tp->fold = fold;
+}
+
+
+/*
+ * Function:    skipSpace
+ *
+ * Complexity:  O(n) where n is the amount of whitespace skipped
+ *
+ * Description: Advance the tokenizer pointed to by TP past any whitespace,
+ *		reading more of the file as needed.  Return false if the
+ *		end of the file is reached first.
+ */
+
+static bool skipSpace(TOKENIZER *tp)
+{
+    while (true) {
+# ifdef __SSE2__
+	while (tp->pos < tp->end) {
+	    __m128i v = _mm_loadu_si128((__m128i *) (tp->buf + tp->pos));
+	    unsigned text = ~spaceMask(v) & 0xffff;
+
+	    if (text != 0) {
+		tp->pos += __builtin_ctz(text);
+		break;
+	    }
+
+	    tp->pos += 16;
+	}
+# else
+	while (tp->pos < tp->end && isSpace(tp->buf[tp->pos]))
+	    tp->pos ++;
+# endif
+
+	if (tp->pos < tp->end)
+	    return true;
+
+	tp->pos = tp->end;
+
+	if (!refill(tp))
+	    return false;
+    }
+}
+
+
+/*
+ * Function:    scanWord
+ *
+ * Complexity:  O(n) where n is the length of the word
+ *
+ * Description: Return the index of the whitespace byte that ends the word
+ *		starting at START in the buffer of the tokenizer pointed to
+ *		by TP, which is the end of the buffer if the word runs off
+ *		of it.  *FIRST and *LAST are set to the first and last bytes
+ *		of the word, or, if folding is on, to its first and last
+ *		bytes that are not punctuation (*FIRST is -1 if there are
+ *		none).  Folding also lowercases the word as it is scanned.
+ */
+
+static int scanWord(TOKENIZER *tp, int start, int *first, int *last)
+{
+    int i;
+    char *buf = tp->buf;
+
+
+    *first = -1;
+    *last = -1;
+    i = start;
+
+# ifdef __SSE2__
+    while (true) {
+	__m128i v = _mm_loadu_si128((__m128i *) (buf + i));
+	unsigned space = spaceMask(v);
+	int stop = space != 0 ? __builtin_ctz(space) : 16;
+
+	if (tp->fold) {
+	    __m128i upper = inRange(v, 'A', 'Z');
+	    __m128i punct = _mm_or_si128(_mm_or_si128(inRange(v, '!', '/'), inRange(v, ':', '@')),
+		_mm_or_si128(inRange(v, '[', '`'), inRange(v, '{', '~')));
+	    unsigned keep = ~_mm_movemask_epi8(punct) & ((1u << stop) - 1);
+
+	    /* Bytes past the end of the word are lowercased too, which is
+	       harmless since they will be lowercased anyway. */
+
+	    v = _mm_or_si128(v, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+	    _mm_storeu_si128((__m128i *) (buf + i), v);
+
+	    if (keep != 0) {
+		if (*first == -1)
+		    *first = i + __builtin_ctz(keep);
+		*last = i + 31 - __builtin_clz(keep);
+	    }
+	}
+
+	if (stop < 16) {
+	    i += stop;
+	    break;
+	}
+
+	i += 16;
+    }
+# else
+    while (!isSpace(buf[i])) {
+	if (tp->fold) {
+	    if (buf[i] >= 'A' && buf[i] <= 'Z')
+		buf[i] += 'a' - 'A';
+
+	    if (!isPunct(buf[i])) {
+		if (*first == -1)
+		    *first = i;
+		*last = i;
+	    }
+	}
+
+	i ++;
+    }
+# endif
+
+    if (!tp->fold) {
+	*first = start;
+	*last = i - 1;
+    }
+
+    return i < tp->end ? i : tp->end;
+}
+
+
+/*
+ * Function:    nextToken
+ *
+ * Complexity:  O(n) where n is the length of the word
+ *
+ * Description: Return the next word in the file of the tokenizer pointed
+ *		to by TP and store its length in *LENGTH, or return NULL at
+ *		the end of the file.  The word is a null-terminated view
+ *		into the buffer of TP that is only valid until the next
+ *		call, so it must be copied if it is to be kept.
+ */
+
+char *nextToken(TOKENIZER *tp, int *length)
+{
+    int start, end, first, last;
+
+
+    assert(tp != NULL && length != NULL);
+
+    while (skipSpace(tp)) {
+	start = tp->pos;
+	end = scanWord(tp, start, &first, &last);
+
+	/* A word cut off by the end of the buffer is scanned again once
+	   the rest of it has been read. */
+
+	if (end == tp->end && !tp->eof) {
+	    tp->pos = start;
+	    refill(tp);
+	    continue;
+	}
+
+	tp->pos = end < tp->end ? end + 1 : end;
+
+	if (first == -1)
+	    continue;
+
+	if (last > end - 1)
+	    last = end - 1;
+
+	tp->buf[last + 1] = '\0';
+	*length = last + 1 - first;
+	return tp->buf + first;
+    }
+
+    return NULL;
+}
+
+
+/*
+ * Function:    splitTokens
+ *
+ * Complexity:  O(n) where n is the size of the block
+ *
+ * Description: Split the SIZE bytes of text at BLOCK into words, storing
+ *		the words in WORDS and their lengths in LENGTHS, and return
+ *		the number of words found.  The block must have room for
+ *		TOKEN_PADDING bytes after its text, and the arrays for at
+ *		least SIZE / 2 + 1 words.  As with nextToken, the words are
+ *		null-terminated views into the block and are folded if FOLD
+ *		is true.
+ */
+
+int splitTokens(char *block, int size, bool fold, char **words, int *lengths)
+{
+    TOKENIZER tk;
+    int n, length;
+    char *word;
+
+
+    assert(block != NULL && words != NULL && lengths != NULL);
+
+    /* A tokenizer over the block that is already at the end of its file
+       never reads, so it simply finds every word in the block. */
+
+    tk.fd = -1;
+    tk.buf = block;
+    tk.size = size;
+    tk.pos = 0;
+    tk.end = size;
+    tk.eof = true;
+    tk.fold = fold;
+    memset(block + size, ' ', PADDING);
+
+    n = 0;
+
+    while ((word = nextToken(&tk, &length)) != NULL) {
+	words[n] = word;
+	lengths[n ++] = length;
+    }
+
+    return n;
+}
+
+
+/*
+ * Function:    copyToken
+ *
+ * Complexity:  O(n) where n is the length of the word
+ *
+ * Description: Return a newly allocated copy of the word TOKEN of the
+ *		given LENGTH, as in strdup() but without measuring it again.
+ */
+
+char *copyToken(char *token, int length)
+{
+    char *copy;
+
+
+    assert(token != NULL);
+
+    copy = malloc(length + 1);
+    assert(copy != NULL);
+
+    memcpy(copy, token, length + 1);
+    return copy;
+}
@@ -0,0 +1,43 @@
+/*
+ * File:        token.h
+ *
+ * Description: This file contains the public function and type
+ *              declarations for a tokenizer that splits a text file into
+ *              whitespace-separated words, exactly as fscanf's "%s"
+ *              conversion would, but without copying each word out of
+ *              the read buffer.  Each word is returned as a pointer into
+ *              the tokenizer's buffer together with its length, and is
+ *              only valid until the next call to nextToken.
+ *
+ *              Folding can optionally be turned on, in which case words
+ *              are lowercased and stripped of leading and trailing
+ *              punctuation so that different spellings of the same word
+ *              are returned the same way.
+ *
+ *              A block of text that is already in memory can also be split
+ *              into words all at once, which is how the words of a file are
+ *              found when the reading is done elsewhere.
+ */
+
+# ifndef TOKEN_H
+# define TOKEN_H
+
+# include <stdbool.h>
+
+# define TOKEN_PADDING 16
+
+typedef struct tokenizer TOKENIZER;
+
+extern TOKENIZER *openTokenizer(char *filename);
+
+extern void closeTokenizer(TOKENIZER *tp);
+
+extern void foldTokens(TOKENIZER *tp, bool fold);
+
+extern char *nextToken(TOKENIZER *tp, int *length);
+
+extern int splitTokens(char *block, int size, bool fold, char **words, int *lengths);
+
+extern char *copyToken(char *token, int length);
+
+# endif /* TOKEN_H */
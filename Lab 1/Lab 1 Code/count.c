@@ -1,43 +1,987 @@
 /*Andrew Vattuone, count.c, 9/20/23
  *User needs to input a file name on compile time. Then opens the
- *file, scans each word and the file, and adds 1 to wordCount whenever a word 
- *is scanned. wordCount is then displayed at the end of the program, which 
- *represents the number of words in the text, and the program ends.
+ *file, scans each word and the file, and adds 1 to wordCount whenever a word
+ *is scanned. wordCount is then displayed at the end of the program, which
+ *represents the number of words in the text, and the program ends. The
+ *number of lines and bytes are counted in the same pass and displayed too.
+ *Regular files are memory-mapped and scanned in place, so words are counted
+ *without being copied anywhere. Pipes and other files that can't be mapped
+ *(or "-" for standard input) are read in large blocks instead. With -j N a
+ *mapped file is split into N byte ranges that are counted on separate threads.
+ *When several files are given, each one is counted and displayed along with a
+ *total for all of them. Their reads are issued asynchronously through io_uring
+ *where the kernel supports it, or by a pool of threads using pread otherwise,
+ *so waiting on the disk overlaps with counting. With --follow a growing file
+ *is watched like tail -f, and only the bytes appended since the last update are
+ *counted. The offset and totals are saved in a small sidecar file next to the
+ *input so a restarted process picks up where the last one stopped.
  */
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#define HAVE_IO_URING
+#endif
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define HAVE_X86
+#endif
+
+#define READ_SIZE (1 << 20)
+#define MAX_THREADS 256
+#define MIN_CHUNK (1 << 20)
+#define READ_AHEAD 16
+#define FOLLOW_INTERVAL 1
+#define SIDECAR_SUFFIX ".count"
+
+//totals reported for the input, in the same order that wc prints them
+typedef struct counts
+{
+	long lines;
+	long words;
+	long bytes;
+}COUNTS;
+
+//one byte range of a mapped file and the totals counted for it by one thread
+typedef struct chunk
+{
+	const char *buf;
+	size_t length;
+	bool inWord;
+	COUNTS counts;
+}CHUNK;
+
+//one file of a batch. blocks and edges are only used by the io_uring reader, which counts the blocks of a file independently of each other
+typedef struct input
+{
+	char *name;
+	int fd;
+	size_t size;
+	int blocks;
+	int issued;
+	int pending;
+	unsigned char *edges;
+	bool failed;
+	COUNTS counts;
+}INPUT;
+
+//what --follow remembers about a file between updates and between runs: which file it was, how far it has been counted, whether that point is in the middle of a word, and the totals so far
+typedef struct follow
+{
+	dev_t dev;
+	ino_t ino;
+	off_t offset;
+	bool inWord;
+	COUNTS counts;
+}FOLLOW;
+
+#define STARTS_IN_WORD 1
+#define ENDS_IN_WORD 2
+
+static void countScalar(const char *buf, size_t n, bool *inWord, COUNTS *cp);
+static void (*countBlock)(const char *buf, size_t n, bool *inWord, COUNTS *cp) = countScalar;
+static int countMapped(int fd, size_t size, int threads, COUNTS *cp);
+static int countBuffered(int fd, COUNTS *cp);
+
+/*Returns true if c is one of the whitespace characters that fscanf's %s stops at (space, \t, \n, \v, \f and \r), so words are split exactly the way the original fscanf loop split them.
+ *Big-O notation: O(1)
+ */
+static inline bool isSpace(unsigned char c)
+{
+	return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+/*Counts the lines, words and bytes in the n bytes of buf one byte at a time and adds them to cp. A word starts at every non-whitespace byte that follows a whitespace byte. inWord carries whether the previous block ended in the middle of a word, so a word split across two blocks is only counted once, and is updated to describe the last byte of buf. Used on machines without vector instructions and for the last few bytes the vector kernels leave over.
+ *Big-O notation: O(n)   where n is the number of bytes in buf
+ */
+static void countScalar(const char *buf, size_t n, bool *inWord, COUNTS *cp)
+{
+	bool in = *inWord;
+	size_t i;
+	for(i = 0; i < n; i++)
+	{
+		bool space = isSpace(buf[i]);
+		//a non-whitespace byte right after whitespace is the start of a new word
+		cp->words += !space && !in;
+		cp->lines += buf[i] == '\n';
+		in = !space;
+	}
+	cp->bytes += n;
+	*inWord = in;
+}
+
+/*Adds the words and lines described by one 64-byte chunk to cp, given a mask with bit i set when byte i is whitespace and a mask of the newline bytes. A word starts wherever a non-whitespace bit follows a whitespace bit, so shifting the non-whitespace mask up by one (carrying in the state of the previous chunk) lines every byte up with the one before it and the word starts can be counted with a single popcount.
+ *Big-O notation: O(1)
+ */
+static inline void countMasks(uint64_t space, uint64_t newline, bool *inWord, COUNTS *cp)
+{
+	uint64_t word = ~space;
+	uint64_t starts = word & ~((word << 1) | *inWord);
+	cp->words += __builtin_popcountll(starts);
+	cp->lines += __builtin_popcountll(newline);
+	*inWord = word >> 63;
+}
+
+#ifdef HAVE_X86
+#ifdef __SSE2__
+/*Returns a 16-bit mask of the whitespace bytes in v. The control characters \t through \r are found with one unsigned range check: subtracting '\t' wraps everything below it around to large values, so a byte is in range exactly when min(byte - '\t', 4) leaves it unchanged.
+ *Big-O notation: O(1)
+ */
+static inline uint64_t spaceMask16(__m128i v)
+{
+	__m128i t = _mm_sub_epi8(v, _mm_set1_epi8('\t'));
+	__m128i ctrl = _mm_cmpeq_epi8(_mm_min_epu8(t, _mm_set1_epi8('\r' - '\t')), t);
+	__m128i blank = _mm_cmpeq_epi8(v, _mm_set1_epi8(' '));
+	return (uint16_t) _mm_movemask_epi8(_mm_or_si128(ctrl, blank));
+}
+
+/*Returns a 16-bit mask of the newline bytes in v.
+ *Big-O notation: O(1)
+ */
+static inline uint64_t newlineMask16(__m128i v)
+{
+	return (uint16_t) _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')));
+}
+
+/*SSE2 version of countScalar. Classifies 64 bytes at a time with four 16-byte compares, then hands the leftover tail to countScalar.
+ *Big-O notation: O(n)   where n is the number of bytes in buf
+ */
+static void countSSE2(const char *buf, size_t n, bool *inWord, COUNTS *cp)
+{
+	size_t i;
+	for(i = 0; i + 64 <= n; i += 64)
+	{
+		uint64_t space = 0, newline = 0;
+		int j;
+		for(j = 0; j < 4; j++)
+		{
+			__m128i v = _mm_loadu_si128((const __m128i *) (buf + i + 16*j));
+			space |= spaceMask16(v) << 16*j;
+			newline |= newlineMask16(v) << 16*j;
+		}
+		countMasks(space, newline, inWord, cp);
+	}
+	cp->bytes += i;
+	countScalar(buf + i, n - i, inWord, cp);
+}
+#endif
+
+/*AVX2 version of countScalar. Classifies 64 bytes at a time with two 32-byte compares, using the same range check as spaceMask16, then hands the leftover tail to countScalar. Compiled for AVX2 regardless of the build flags and only chosen at run time if the processor supports it.
+ *Big-O notation: O(n)   where n is the number of bytes in buf
+ */
+__attribute__((target("avx2,popcnt")))
+static void countAVX2(const char *buf, size_t n, bool *inWord, COUNTS *cp)
+{
+	const __m256i tab = _mm256_set1_epi8('\t');
+	const __m256i range = _mm256_set1_epi8('\r' - '\t');
+	const __m256i blank = _mm256_set1_epi8(' ');
+	const __m256i nl = _mm256_set1_epi8('\n');
+	size_t i;
+	for(i = 0; i + 64 <= n; i += 64)
+	{
+		uint64_t space = 0, newline = 0;
+		int j;
+		for(j = 0; j < 2; j++)
+		{
+			__m256i v = _mm256_loadu_si256((const __m256i *) (buf + i + 32*j));
+			__m256i t = _mm256_sub_epi8(v, tab);
+			__m256i ws = _mm256_or_si256(_mm256_cmpeq_epi8(_mm256_min_epu8(t, range), t), _mm256_cmpeq_epi8(v, blank));
+			space |= (uint64_t) (uint32_t) _mm256_movemask_epi8(ws) << 32*j;
+			newline |= (uint64_t) (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, nl)) << 32*j;
+		}
+		countMasks(space, newline, inWord, cp);
+	}
+	cp->bytes += i;
+	countScalar(buf + i, n - i, inWord, cp);
+}
+#endif
+
+/*Picks the fastest counting kernel the processor supports: AVX2 if available, otherwise SSE2 if the build targets it, otherwise the scalar loop.
+ *Big-O notation: O(1)
+ */
+static void chooseKernel(void)
+{
+#ifdef HAVE_X86
+	__builtin_cpu_init();
+	if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt"))
+	{
+		countBlock = countAVX2;
+		return;
+	}
+#ifdef __SSE2__
+	countBlock = countSSE2;
+#endif
+#endif
+}
+
+/*Thread body for countMapped. Counts the byte range described by the chunk arg into its own totals, so no locking is needed.
+ *Big-O notation: O(n)   where n is the length of the chunk
+ */
+static void *countChunk(void *arg)
+{
+	CHUNK *cp = arg;
+	countBlock(cp->buf, cp->length, &cp->inWord, &cp->counts);
+	return NULL;
+}
+
+/*Maps the whole file fd of the given size into memory and counts it in place, adding the totals to cp. The kernel is told the mapping will be read sequentially so it can read ahead aggressively. If threads is more than 1 the mapping is split into that many byte ranges (fewer if the file is small) and each range is counted on its own thread. A word that straddles a range boundary is stitched back together by starting each range with inWord set from the last byte of the range before it, so the word is only counted by the range it started in and the totals match a single-threaded count exactly. Returns -1 if the file couldn't be mapped so the caller can fall back to reading it, and 0 otherwise.
+ *Big-O notation: O(n/t)   where n is the size of the file in bytes and t is the number of threads
+ */
+static int countMapped(int fd, size_t size, int threads, COUNTS *cp)
+{
+	char *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if(map == MAP_FAILED)
+	{
+		return -1;
+	}
+	madvise(map, size, MADV_SEQUENTIAL);
+
+	//doesn't split the file into ranges too small to be worth a thread
+	if((size_t) threads > size/MIN_CHUNK + 1)
+	{
+		threads = size/MIN_CHUNK + 1;
+	}
+	CHUNK chunks[MAX_THREADS];
+	pthread_t tids[MAX_THREADS];
+	size_t start = 0;
+	int i;
+	for(i = 0; i < threads; i++)
+	{
+		size_t end = size/threads*(i+1);
+		if(i == threads-1)
+		{
+			end = size;
+		}
+		chunks[i].buf = map + start;
+		chunks[i].length = end - start;
+		chunks[i].inWord = start > 0 && !isSpace(map[start-1]);
+		memset(&chunks[i].counts, 0, sizeof(COUNTS));
+		start = end;
+	}
+
+	//the calling thread counts the first range itself while the others run, and counts everything if a thread can't be started
+	int started = 1;
+	while(started < threads && pthread_create(&tids[started], NULL, countChunk, &chunks[started]) == 0)
+	{
+		started++;
+	}
+	countChunk(&chunks[0]);
+	for(i = 1; i < threads; i++)
+	{
+		if(i < started)
+		{
+			pthread_join(tids[i], NULL);
+		}
+		else
+		{
+			countChunk(&chunks[i]);
+		}
+		chunks[0].counts.lines += chunks[i].counts.lines;
+		chunks[0].counts.words += chunks[i].counts.words;
+		chunks[0].counts.bytes += chunks[i].counts.bytes;
+	}
+	cp->lines += chunks[0].counts.lines;
+	cp->words += chunks[0].counts.words;
+	cp->bytes += chunks[0].counts.bytes;
+	munmap(map, size);
+	return 0;
+}
+
+/*Reads fd in READ_SIZE blocks until the end of the input and counts each block, adding the totals to cp. Used for pipes and anything else that can't be memory-mapped. Returns -1 if a read fails and 0 otherwise.
+ *Big-O notation: O(n)   where n is the number of bytes read
+ */
+static int countBuffered(int fd, COUNTS *cp)
+{
+	char *buf = malloc(READ_SIZE);
+	if(buf == NULL)
+	{
+		return -1;
+	}
+	bool inWord = false;
+	ssize_t n;
+	while((n = read(fd, buf, READ_SIZE)) != 0)
+	{
+		if(n < 0)
+		{
+			free(buf);
+			return -1;
+		}
+		countBlock(buf, n, &inWord, cp);
+	}
+	free(buf);
+	return 0;
+}
+
+/*Reads fd with pread in READ_SIZE blocks from offset to the current end of the file and counts each block into cp, carrying inWord from block to block. Returns the offset the file was counted up to, or -1 if a read fails.
+ *Big-O notation: O(n)   where n is the number of bytes after offset
+ */
+static off_t countFrom(int fd, off_t offset, bool *inWord, COUNTS *cp, char *buf)
+{
+	ssize_t n;
+	while((n = pread(fd, buf, READ_SIZE, offset)) > 0)
+	{
+		countBlock(buf, n, inWord, cp);
+		offset += n;
+	}
+	return n < 0 ? -1 : offset;
+}
+
+/*Counts one file of a batch into its own totals, reading regular files with countFrom into the given buffer and anything else with countBuffered. Sets the failed flag of ip if the file couldn't be opened or read.
+ *Big-O notation: O(n)   where n is the size of the file in bytes
+ */
+static void countInput(INPUT *ip, char *buf)
+{
+	int fd = strcmp(ip->name, "-") == 0 ? STDIN_FILENO : open(ip->name, O_RDONLY);
+	if(fd < 0)
+	{
+		ip->failed = true;
+		return;
+	}
+	struct stat st;
+	if(fstat(fd, &st) == 0 && S_ISREG(st.st_mode))
+	{
+		posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+		bool inWord = false;
+		ip->failed = countFrom(fd, 0, &inWord, &ip->counts, buf) < 0;
+	}
+	else
+	{
+		ip->failed = countBuffered(fd, &ip->counts) < 0;
+	}
+	if(fd != STDIN_FILENO)
+	{
+		close(fd);
+	}
+}
+
+//shared state of the pread thread pool: the batch and the index of the next file that hasn't been claimed by a thread
+typedef struct pool
+{
+	INPUT *inputs;
+	int count;
+	int next;
+}POOL;
+
+/*Thread body for countPool. Repeatedly claims the next unclaimed file of the batch and counts it, until every file has been claimed.
+ *Big-O notation: O(n)   where n is the total size of the files counted by this thread
+ */
+static void *poolWorker(void *arg)
+{
+	POOL *pp = arg;
+	char *buf = malloc(READ_SIZE);
+	int i;
+	while((i = __atomic_fetch_add(&pp->next, 1, __ATOMIC_RELAXED)) < pp->count)
+	{
+		if(buf == NULL)
+		{
+			pp->inputs[i].failed = true;
+			continue;
+		}
+		countInput(&pp->inputs[i], buf);
+	}
+	free(buf);
+	return NULL;
+}
+
+/*Counts a batch of n files using a pool of threads that each read and count whole files, so up to threads reads are waiting on the disk while the others count. Fallback for kernels without io_uring.
+ *Big-O notation: O(n)   where n is the total size of the files
+ */
+static void countPool(INPUT *inputs, int n, int threads)
+{
+	POOL pool = {inputs, n, 0};
+	pthread_t tids[MAX_THREADS];
+	int started = 0;
+	if(threads > n)
+	{
+		threads = n;
+	}
+	while(started < threads - 1 && pthread_create(&tids[started], NULL, poolWorker, &pool) == 0)
+	{
+		started++;
+	}
+	poolWorker(&pool);
+	int i;
+	for(i = 0; i < started; i++)
+	{
+		pthread_join(tids[i], NULL);
+	}
+}
+
+#ifdef HAVE_IO_URING
+//the submission and completion queues shared with the kernel by one io_uring instance, set up without liburing
+typedef struct ring
+{
+	int fd;
+	unsigned *sqTail;
+	unsigned *sqMask;
+	unsigned *sqArray;
+	struct io_uring_sqe *sqes;
+	unsigned *cqHead;
+	unsigned *cqTail;
+	unsigned *cqMask;
+	struct io_uring_cqe *cqes;
+	void *sqMap;
+	void *cqMap;
+	size_t sqMapSize;
+	size_t cqMapSize;
+	size_t sqesSize;
+}RING;
+
+//one read in flight: which block of which file it belongs to and how much of the block has arrived so far
+typedef struct slot
+{
+	INPUT *input;
+	int block;
+	size_t length;
+	size_t done;
+	char *buf;
+	struct iovec iov;
+}SLOT;
+
+/*Creates an io_uring instance with room for entries reads in flight and maps its queues into rp. Returns -1 if the kernel doesn't support io_uring (or doesn't allow it), in which case the caller falls back to the thread pool.
+ *Big-O notation: O(1)
+ */
+static int setupRing(RING *rp, unsigned entries)
+{
+	struct io_uring_params params;
+	memset(&params, 0, sizeof(params));
+	rp->fd = syscall(__NR_io_uring_setup, entries, &params);
+	if(rp->fd < 0)
+	{
+		return -1;
+	}
+	rp->sqMapSize = params.sq_off.array + params.sq_entries*sizeof(unsigned);
+	rp->cqMapSize = params.cq_off.cqes + params.cq_entries*sizeof(struct io_uring_cqe);
+	//newer kernels share one mapping between both rings
+	if(params.features & IORING_FEAT_SINGLE_MMAP)
+	{
+		if(rp->cqMapSize > rp->sqMapSize)
+		{
+			rp->sqMapSize = rp->cqMapSize;
+		}
+		rp->cqMapSize = rp->sqMapSize;
+	}
+	rp->sqMap = mmap(NULL, rp->sqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, rp->fd, IORING_OFF_SQ_RING);
+	rp->cqMap = rp->sqMap;
+	if(rp->sqMap != MAP_FAILED && !(params.features & IORING_FEAT_SINGLE_MMAP))
+	{
+		rp->cqMap = mmap(NULL, rp->cqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, rp->fd, IORING_OFF_CQ_RING);
+	}
+	rp->sqesSize = params.sq_entries*sizeof(struct io_uring_sqe);
+	rp->sqes = mmap(NULL, rp->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, rp->fd, IORING_OFF_SQES);
+	if(rp->sqMap == MAP_FAILED || rp->cqMap == MAP_FAILED || rp->sqes == MAP_FAILED)
+	{
+		close(rp->fd);
+		return -1;
+	}
+	char *sq = rp->sqMap;
+	char *cq = rp->cqMap;
+	rp->sqTail = (unsigned *) (sq + params.sq_off.tail);
+	rp->sqMask = (unsigned *) (sq + params.sq_off.ring_mask);
+	rp->sqArray = (unsigned *) (sq + params.sq_off.array);
+	rp->cqHead = (unsigned *) (cq + params.cq_off.head);
+	rp->cqTail = (unsigned *) (cq + params.cq_off.tail);
+	rp->cqMask = (unsigned *) (cq + params.cq_off.ring_mask);
+	rp->cqes = (struct io_uring_cqe *) (cq + params.cq_off.cqes);
+	return 0;
+}
+
+/*Unmaps the queues of rp and closes the io_uring instance.
+ *Big-O notation: O(1)
+ */
+static void destroyRing(RING *rp)
+{
+	munmap(rp->sqes, rp->sqesSize);
+	if(rp->cqMap != rp->sqMap)
+	{
+		munmap(rp->cqMap, rp->cqMapSize);
+	}
+	munmap(rp->sqMap, rp->sqMapSize);
+	close(rp->fd);
+}
+
+/*Queues a read of the rest of the block described by sp. The tail is published with a release store so the kernel sees the filled-in entry before it sees the new tail.
+ *Big-O notation: O(1)
+ */
+static void queueRead(RING *rp, SLOT *sp)
+{
+	unsigned tail = *rp->sqTail;
+	unsigned index = tail & *rp->sqMask;
+	struct io_uring_sqe *sqe = &rp->sqes[index];
+	memset(sqe, 0, sizeof(*sqe));
+	sp->iov.iov_base = sp->buf + sp->done;
+	sp->iov.iov_len = sp->length - sp->done;
+	sqe->opcode = IORING_OP_READV;
+	sqe->fd = sp->input->fd;
+	sqe->addr = (unsigned long) &sp->iov;
+	sqe->len = 1;
+	sqe->off = (size_t) sp->block*READ_SIZE + sp->done;
+	sqe->user_data = (unsigned long) sp;
+	rp->sqArray[index] = index;
+	__atomic_store_n(rp->sqTail, tail + 1, __ATOMIC_RELEASE);
+}
+
+/*Opens the next file of the batch that still has data to read and returns it, or returns NULL once every file has been opened. Files that are empty, can't be opened, or aren't regular files are finished on the spot (the last using countBuffered), since there is nothing for io_uring to read at an offset.
+ *Big-O notation: O(1) amortized
+ */
+static INPUT *nextInput(INPUT *inputs, int n, int *next, char *buf)
+{
+	while(*next < n)
+	{
+		INPUT *ip = &inputs[(*next)++];
+		struct stat st;
+		ip->fd = strcmp(ip->name, "-") == 0 ? -1 : open(ip->name, O_RDONLY);
+		if(ip->fd < 0 || fstat(ip->fd, &st) != 0 || !S_ISREG(st.st_mode))
+		{
+			if(ip->fd >= 0)
+			{
+				close(ip->fd);
+			}
+			countInput(ip, buf);
+			continue;
+		}
+		ip->size = st.st_size;
+		ip->blocks = (ip->size + READ_SIZE - 1)/READ_SIZE;
+		ip->edges = calloc(ip->blocks + 1, 1);
+		if(ip->blocks == 0 || ip->edges == NULL)
+		{
+			ip->failed = ip->edges == NULL;
+			close(ip->fd);
+			continue;
+		}
+		return ip;
+	}
+	return NULL;
+}
+
+/*Counts the block held by a slot whose read has finished, recording whether its first and last bytes are inside a word so finishInput can stitch the blocks together. Closes the file once all of its blocks are done.
+ *Big-O notation: O(n)   where n is the length of the block
+ */
+static void countSlot(SLOT *sp)
+{
+	INPUT *ip = sp->input;
+	if(sp->done > 0)
+	{
+		bool inWord = false;
+		countBlock(sp->buf, sp->done, &inWord, &ip->counts);
+		ip->edges[sp->block] = (!isSpace(sp->buf[0]) ? STARTS_IN_WORD : 0) | (!isSpace(sp->buf[sp->done-1]) ? ENDS_IN_WORD : 0);
+	}
+	ip->pending--;
+	if(ip->pending == 0 && ip->issued == ip->blocks)
+	{
+		close(ip->fd);
+	}
+}
+
+/*Starts over on a file whose blocks were only partly read when the ring had to be given up. Closes it, forgets the blocks that were already counted, and counts the whole file again with countInput.
+ *Big-O notation: O(n)   where n is the size of the file in bytes
+ */
+static void recountInput(INPUT *ip, char *buf)
+{
+	close(ip->fd);
+	free(ip->edges);
+	ip->edges = NULL;
+	ip->blocks = 0;
+	ip->issued = 0;
+	ip->pending = 0;
+	ip->failed = false;
+	memset(&ip->counts, 0, sizeof(ip->counts));
+	countInput(ip, buf);
+}
+
+/*Counts a batch of n files through io_uring. Up to READ_AHEAD block reads (from one file or many) are kept in flight at once, and each block is counted as soon as its read completes, in whatever order the kernel finishes them. Every block is counted as if it started outside a word, and finishInput later removes the words that were counted twice because they straddled two blocks. Returns the number of files at the front of the batch that were counted, which is 0 if io_uring isn't available. If io_uring_enter fails with anything but an error that asks for a retry, the ring is given up: the files it had started are counted again from the beginning, and the files it never reached are left for the caller to count with the thread pool.
+ *Big-O notation: O(n)   where n is the total size of the files
+ */
+static int countRing(INPUT *inputs, int n)
+{
+	RING ring;
+	if(setupRing(&ring, READ_AHEAD) < 0)
+	{
+		return 0;
+	}
+	char *bufs = malloc((size_t) READ_AHEAD*READ_SIZE);
+	char *spare = malloc(READ_SIZE);
+	SLOT slots[READ_AHEAD];
+	SLOT *idle[READ_AHEAD];
+	if(bufs == NULL || spare == NULL)
+	{
+		free(bufs);
+		free(spare);
+		destroyRing(&ring);
+		return 0;
+	}
+	int nidle;
+	for(nidle = 0; nidle < READ_AHEAD; nidle++)
+	{
+		slots[nidle].buf = bufs + (size_t) nidle*READ_SIZE;
+		idle[nidle] = &slots[nidle];
+	}
+
+	int next = 0;
+	unsigned queued = 0;
+	INPUT *current = nextInput(inputs, n, &next, spare);
+	while(current != NULL || nidle < READ_AHEAD)
+	{
+		//fills every idle slot with the next block to read, moving on to later files as earlier ones are fully issued
+		while(nidle > 0 && current != NULL)
+		{
+			SLOT *sp = idle[--nidle];
+			sp->input = current;
+			sp->block = current->issued++;
+			sp->length = current->size - (size_t) sp->block*READ_SIZE;
+			sp->length = sp->length < READ_SIZE ? sp->length : READ_SIZE;
+			sp->done = 0;
+			current->pending++;
+			queueRead(&ring, sp);
+			queued++;
+			if(current->issued == current->blocks)
+			{
+				current = nextInput(inputs, n, &next, spare);
+			}
+		}
+
+		//submits the new reads and waits for at least one to finish. Reads the kernel didn't accept yet stay queued for the next call
+		int submitted = syscall(__NR_io_uring_enter, ring.fd, queued, 1, IORING_ENTER_GETEVENTS, NULL, 0);
+		if(submitted < 0 && (errno == EINTR || errno == EAGAIN || errno == EBUSY))
+		{
+			continue;
+		}
+		if(submitted < 0)
+		{
+			break;
+		}
+		queued -= submitted;
+
+		unsigned head = *ring.cqHead;
+		while(head != __atomic_load_n(ring.cqTail, __ATOMIC_ACQUIRE))
+		{
+			struct io_uring_cqe *cqe = &ring.cqes[head & *ring.cqMask];
+			SLOT *sp = (SLOT *) (unsigned long) cqe->user_data;
+			int res = cqe->res;
+			head++;
+			if(res < 0)
+			{
+				sp->input->failed = true;
+			}
+			else
+			{
+				sp->done += res;
+			}
+			//a short read is resubmitted for the rest of the block unless the file ended early
+			if(res > 0 && sp->done < sp->length)
+			{
+				queueRead(&ring, sp);
+				queued++;
+				continue;
+			}
+			countSlot(sp);
+			idle[nidle++] = sp;
+		}
+		__atomic_store_n(ring.cqHead, head, __ATOMIC_RELEASE);
+	}
+
+	//the loop only ends with reads outstanding if io_uring_enter failed. Reads the kernel already accepted may still land in bufs after the ring is closed, so bufs is only freed when none are left
+	int inFlight = READ_AHEAD - nidle - queued;
+	destroyRing(&ring);
+	if(inFlight == 0)
+	{
+		free(bufs);
+	}
+	if(current == NULL && nidle == READ_AHEAD)
+	{
+		free(spare);
+		return n;
+	}
+	int i;
+	for(i = 0; i < next; i++)
+	{
+		if(inputs[i].edges != NULL && (inputs[i].pending > 0 || inputs[i].issued < inputs[i].blocks))
+		{
+			recountInput(&inputs[i], spare);
+		}
+	}
+	free(spare);
+	return next;
+}
+#endif
+
+/*Finishes the totals of a file counted block by block by taking away one word for every pair of neighboring blocks where the first ends in a word and the second starts in one, since that word was counted by both.
+ *Big-O notation: O(b)   where b is the number of blocks in the file
+ */
+static void finishInput(INPUT *ip)
+{
+	int i;
+	for(i = 1; i < ip->blocks; i++)
+	{
+		if((ip->edges[i-1] & ENDS_IN_WORD) && (ip->edges[i] & STARTS_IN_WORD))
+		{
+			ip->counts.words--;
+		}
+	}
+	free(ip->edges);
+}
+
+/*Counts every file in names and displays the lines, words and bytes of each one followed by the totals for all of them, in the same layout as wc. Reads go through io_uring when available and through a pool of pread threads otherwise, or for the files io_uring didn't get to if it had to be given up partway.
+ *Big-O notation: O(n)   where n is the total size of the files
+ */
+static void countBatch(char **names, int n, int threads)
+{
+	INPUT *inputs = calloc(n, sizeof(INPUT));
+	if(inputs == NULL)
+	{
+		printf("Error. Not enough memory to count %d files.\n", n);
+		return;
+	}
+	int i;
+	for(i = 0; i < n; i++)
+	{
+		inputs[i].name = names[i];
+	}
+
+	int counted = 0;
+#ifdef HAVE_IO_URING
+	counted = countRing(inputs, n);
+#endif
+	if(counted < n)
+	{
+		countPool(inputs + counted, n - counted, threads);
+	}
+
+	COUNTS total = {0, 0, 0};
+	for(i = 0; i < n; i++)
+	{
+		finishInput(&inputs[i]);
+		if(inputs[i].failed)
+		{
+			printf("Error. File %s could not be read successfully.\n", inputs[i].name);
+			continue;
+		}
+		printf("%8ld %8ld %8ld %s\n", inputs[i].counts.lines, inputs[i].counts.words, inputs[i].counts.bytes, inputs[i].name);
+		total.lines += inputs[i].counts.lines;
+		total.words += inputs[i].counts.words;
+		total.bytes += inputs[i].counts.bytes;
+	}
+	printf("%8ld %8ld %8ld total\n", total.lines, total.words, total.bytes);
+	free(inputs);
+}
+
+/*Loads the state saved by an earlier --follow run from the sidecar file at path into fp. The saved state is only used if it describes the same file (same device and inode) and the file hasn't shrunk below the saved offset since, otherwise fp is left alone and the file is counted from the start.
+ *Big-O notation: O(1)
+ */
+static void loadFollow(char *path, FOLLOW *fp, struct stat *st)
+{
+	FILE *sidecar = fopen(path, "r");
+	if(sidecar == NULL)
+	{
+		return;
+	}
+	unsigned long dev, ino;
+	long long offset;
+	int inWord;
+	COUNTS counts;
+	if(fscanf(sidecar, "%lu %lu %lld %d %ld %ld %ld", &dev, &ino, &offset, &inWord, &counts.lines, &counts.words, &counts.bytes) == 7 && dev == st->st_dev && ino == st->st_ino && offset <= st->st_size)
+	{
+		fp->offset = offset;
+		fp->inWord = inWord;
+		fp->counts = counts;
+	}
+	fclose(sidecar);
+}
+
+/*Saves the state in fp to the sidecar file at path. The state is written to a temporary file that is then renamed over the sidecar, so a process killed halfway through never leaves a half-written sidecar behind.
+ *Big-O notation: O(1)
+ */
+static void saveFollow(char *path, FOLLOW *fp)
+{
+	char temp[PATH_MAX + sizeof(".tmp")];
+	snprintf(temp, sizeof(temp), "%s.tmp", path);
+	FILE *sidecar = fopen(temp, "w");
+	if(sidecar == NULL)
+	{
+		return;
+	}
+	fprintf(sidecar, "%lu %lu %lld %d %ld %ld %ld\n", (unsigned long) fp->dev, (unsigned long) fp->ino, (long long) fp->offset, fp->inWord, fp->counts.lines, fp->counts.words, fp->counts.bytes);
+	if(fclose(sidecar) == 0)
+	{
+		rename(temp, path);
+	}
+}
+
+/*Watches the file called name and displays its lines, words and bytes every time it grows, like tail -f for word totals. Only the bytes appended since the last update are counted, starting from the saved offset with the saved inWord state so a word that was still being written at the last update isn't counted twice. If the file is truncated or replaced by a new file (as when a log is rotated), counting starts over from the beginning. Never returns unless the file can't be opened or read.
+ *Big-O notation: O(a) per update   where a is the number of bytes appended since the last update
+ */
+static void followFile(char *name)
+{
+	char sidecar[PATH_MAX];
+	snprintf(sidecar, sizeof(sidecar), "%s%s", name, SIDECAR_SUFFIX);
+	char *buf = malloc(READ_SIZE);
+	int fd = open(name, O_RDONLY);
+	struct stat st;
+	if(buf == NULL || fd < 0 || fstat(fd, &st) != 0)
+	{
+		printf("Error. File could not be opened successfully. Please try again.\n");
+		free(buf);
+		return;
+	}
+	FOLLOW follow = {st.st_dev, st.st_ino, 0, false, {0, 0, 0}};
+	loadFollow(sidecar, &follow, &st);
+	bool changed = true;
+	while(true)
+	{
+		//starts over when the name now refers to a different file, or when the file got shorter than what was already counted
+		struct stat named;
+		if(stat(name, &named) == 0 && (named.st_dev != follow.dev || named.st_ino != follow.ino))
+		{
+			int newfd = open(name, O_RDONLY);
+			if(newfd >= 0)
+			{
+				close(fd);
+				fd = newfd;
+			}
+		}
+		if(fstat(fd, &st) != 0)
+		{
+			break;
+		}
+		if(st.st_dev != follow.dev || st.st_ino != follow.ino || st.st_size < follow.offset)
+		{
+			FOLLOW fresh = {st.st_dev, st.st_ino, 0, false, {0, 0, 0}};
+			follow = fresh;
+			changed = true;
+		}
+
+		if(st.st_size > follow.offset)
+		{
+			off_t offset = countFrom(fd, follow.offset, &follow.inWord, &follow.counts, buf);
+			if(offset < 0)
+			{
+				printf("Error. File could not be read successfully. Please try again.\n");
+				break;
+			}
+			follow.offset = offset;
+			changed = true;
+		}
+		if(changed)
+		{
+			saveFollow(sidecar, &follow);
+			printf("%8ld %8ld %8ld %s\n", follow.counts.lines, follow.counts.words, follow.counts.bytes, name);
+			fflush(stdout);
+			changed = false;
+		}
+		sleep(FOLLOW_INTERVAL);
+	}
+	close(fd);
+	free(buf);
+}
 
-#define MAX_WORD_LENGTH 30
 /*
- * Driver function. Runs the program. 
+ * Driver function. Runs the program.
  */
 int main(int argc, char *argv[])
 {
+	//-j N counts a mapped file on N threads, or sets the size of the thread pool when several files are counted. --follow keeps counting a growing file
+	int threads = 0;
+	bool follow = false;
+	while(argc > 1)
+	{
+		if(argc > 2 && strcmp(argv[1], "-j") == 0)
+		{
+			threads = atoi(argv[2]);
+			if(threads < 1 || threads > MAX_THREADS)
+			{
+				printf("Error. The number of threads must be between 1 and %d.\n", MAX_THREADS);
+				return 0;
+			}
+			argc -= 2;
+			argv += 2;
+		}
+		else if(strcmp(argv[1], "--follow") == 0)
+		{
+			follow = true;
+			argc--;
+			argv++;
+		}
+		else
+		{
+			break;
+		}
+	}
+
 	//returns an error and ends the program if the user doesn't enter a file name
 	if(argc <= 1)
 	{
 		printf("Error. The file name is missing. Please select an existing file!\n");
 		return 0;
 	}
-	
-	FILE *fptr;
-	fptr = fopen(argv[1], "r");
+	chooseKernel();
 
-	//returns an error and ends the program if the file wasn't successfully opened 
-	if(fptr == NULL)
+	//only a single named file can be followed
+	if(follow)
+	{
+		if(argc != 2 || strcmp(argv[1], "-") == 0)
+		{
+			printf("Error. --follow needs exactly one file name.\n");
+			return 0;
+		}
+		followFile(argv[1]);
+		return 0;
+	}
+
+	//counts several files as one batch
+	if(argc > 2)
+	{
+		countBatch(argv + 1, argc - 1, threads > 0 ? threads : READ_AHEAD);
+		return 0;
+	}
+
+	//"-" reads the words from standard input instead of from a named file
+	int fd = strcmp(argv[1], "-") == 0 ? STDIN_FILENO : open(argv[1], O_RDONLY);
+
+	//returns an error and ends the program if the file wasn't successfully opened
+	if(fd < 0)
 	{
 		printf("Error. File could not be opened successfully. Please try again.\n");
 		return 0;
 	}
-	int wordCount = 0;
-	char word[MAX_WORD_LENGTH];
-	//scans each word in the text and adds 1 to wordCount until the end of  the file
-	while(fscanf(fptr, "%s", word) == 1)
+
+	//regular files are counted straight out of a memory mapping, and everything else falls back to buffered reads
+	struct stat st;
+	COUNTS counts = {0, 0, 0};
+	int status = -1;
+	if(fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+	{
+		status = countMapped(fd, st.st_size, threads > 0 ? threads : 1, &counts);
+	}
+	if(status < 0)
 	{
-		wordCount++;
+		status = countBuffered(fd, &counts);
+	}
+	if(status < 0)
+	{
+		printf("Error. File could not be read successfully. Please try again.\n");
+		close(fd);
+		return 0;
 	}
 
-	printf("%d total words\n", wordCount);
-	fclose(fptr);
+	printf("%ld total lines\n", counts.lines);
+	printf("%ld total words\n", counts.words);
+	printf("%ld total bytes\n", counts.bytes);
+	close(fd);
 	return 0;
 }
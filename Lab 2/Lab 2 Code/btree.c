@@ -0,0 +1,759 @@
+/*btree.c
+ *Various functions that are used by files unique.c and parity.c to manipulate a set of strings, like unsorted.c and sorted.c but with the strings held in a B+tree instead of a single array. The strings themselves are all held in the leaves of the tree in alphabetical order, and each leaf is linked to the one after it so that the strings can be listed in order by walking the leaves. Each leaf holds only a few strings so that it fits in a single 64-byte cache line, which keeps the shifting done by an insertion or deletion small no matter how many strings are in the set. The inner nodes above the leaves hold strings that separate their children, and are used to find the leaf a string belongs in. Every string is copied into an arena that is freed all at once with the set, so a separator can simply point to the same copy as the string in the leaf, even after that string has been removed. Insertions split full nodes and deletions borrow from or merge with neighboring nodes, so the tree stays balanced.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <stdbool.h>
+#include "set.h"
+#include "arena.h"
+
+#define LEAF_KEYS 6
+#define LEAF_MIN (LEAF_KEYS/2)
+#define INNER_KEYS 15
+#define INNER_MIN (INNER_KEYS/2)
+
+//results of inserting a string into a subtree
+enum {DUPLICATE, INSERTED, SPLIT};
+
+//a leaf holds up to LEAF_KEYS strings in alphabetical order and a pointer to the next leaf, all within one cache line
+typedef struct leaf
+{
+	char *keys[LEAF_KEYS];
+	struct leaf *next;
+	int count;
+}__attribute__((aligned(64))) LEAF;
+
+//an inner node holds count separators, with children[i] holding the strings that are at least keys[i-1] and less than keys[i]
+typedef struct inner
+{
+	char *keys[INNER_KEYS];
+	void *children[INNER_KEYS+1];
+	int count;
+}INNER;
+
+//definition of the structure set
+typedef struct set
+{
+	void *root;
+	LEAF *first;
+	ARENA *arena;
+	int height;
+	int length;
+	int count;
+}SET;
+
+
+/*Allocates a new empty leaf, aligned to a cache line. Assert is used to make sure the pointer is not null.
+ *Big-O notation: O(1)
+ */
+static LEAF *newLeaf(void)
+{
+	LEAF *lp = aligned_alloc(64, sizeof(LEAF));
+	assert(lp != NULL);
+	lp->next = NULL;
+	lp->count = 0;
+	return lp;
+}
+
+/*Allocates a new empty inner node. Assert is used to make sure the pointer is not null.
+ *Big-O notation: O(1)
+ */
+static INNER *newInner(void)
+{
+	INNER *ip = malloc(sizeof(INNER));
+	assert(ip != NULL);
+	ip->count = 0;
+	return ip;
+}
+
+/*Compares the two strings pointed to by p and q, for sorting an array of strings with qsort.
+ *Big-O notation: O(1)
+ */
+static int compareStrings(const void *p, const void *q)
+{
+	return strcmp(*(char **)p, *(char **)q);
+}
+
+/*Searches leaf lp for elt, returning the index elt is located at or the index where it should be inserted. Uses a boolean value passed in by reference to indicate whether elt was found. A linear search is used since a leaf only holds a few strings.
+ *Big-O notation: O(1)
+ */
+static int searchLeaf(LEAF *lp, char *elt, bool *found)
+{
+	int i, result;
+	for(i = 0; i < lp->count; i++)
+	{
+		result = strcmp(lp->keys[i], elt);
+		if(result >= 0)
+		{
+			*found = (result == 0);
+			return i;
+		}
+	}
+	*found = false;
+	return i;
+}
+
+/*Searches inner node ip for the index of the child that elt belongs in, which is the number of separators that are less than or equal to elt. Uses binary search.
+ *Big-O notation: O(1)
+ */
+static int searchInner(INNER *ip, char *elt)
+{
+	int low = 0;
+	int high = ip->count;
+	int mid;
+	while(low < high)
+	{
+		mid = (low+high)/2;
+		if(strcmp(ip->keys[mid], elt) <= 0)
+		{
+			low = mid + 1;
+		}
+		else
+		{
+			high = mid;
+		}
+	}
+	return low;
+}
+
+/*Inserts a copy of elt, made in arena, into leaf lp. If the leaf is full, it is split in two, and the new right half and its first string are passed back through right and sep to be added to the parent. Returns DUPLICATE if elt is already in the leaf, and otherwise INSERTED or SPLIT.
+ *Big-O notation: O(1)
+ */
+static int insertLeaf(LEAF *lp, ARENA *arena, char *elt, int length, char **sep, void **right)
+{
+	bool found;
+	int pos = searchLeaf(lp, elt, &found);
+	if(found)
+	{
+		return DUPLICATE;
+	}
+
+	char *copy = copyArena(arena, elt, length);
+	if(lp->count < LEAF_KEYS)
+	{
+		memmove(&lp->keys[pos+1], &lp->keys[pos], sizeof(char*)*(lp->count-pos));
+		lp->keys[pos] = copy;
+		lp->count++;
+		return INSERTED;
+	}
+
+	//puts all LEAF_KEYS+1 strings in order and gives the upper half of them to a new leaf
+	char *keys[LEAF_KEYS+1];
+	memcpy(keys, lp->keys, sizeof(char*)*pos);
+	keys[pos] = copy;
+	memcpy(&keys[pos+1], &lp->keys[pos], sizeof(char*)*(LEAF_KEYS-pos));
+
+	LEAF *rp = newLeaf();
+	lp->count = (LEAF_KEYS+2)/2;
+	rp->count = LEAF_KEYS+1-lp->count;
+	memcpy(lp->keys, keys, sizeof(char*)*lp->count);
+	memcpy(rp->keys, &keys[lp->count], sizeof(char*)*rp->count);
+	rp->next = lp->next;
+	lp->next = rp;
+
+	*sep = rp->keys[0];
+	*right = rp;
+	return SPLIT;
+}
+
+/*Inserts a copy of elt into the subtree rooted at node, which has height levels of inner nodes above its leaves. A child that splits has its new separator and right half added to node, and if node is full it is split in turn, with its middle separator moved up through sep and its right half passed back through right. Returns DUPLICATE, INSERTED, or SPLIT.
+ *Big-O notation: O(log(n))
+ */
+static int insert(void *node, int height, ARENA *arena, char *elt, int length, char **sep, void **right)
+{
+	if(height == 0)
+	{
+		return insertLeaf(node, arena, elt, length, sep, right);
+	}
+
+	INNER *ip = node;
+	int i = searchInner(ip, elt);
+	char *childSep;
+	void *childRight;
+	int result = insert(ip->children[i], height-1, arena, elt, length, &childSep, &childRight);
+	if(result != SPLIT)
+	{
+		return result;
+	}
+
+	if(ip->count < INNER_KEYS)
+	{
+		memmove(&ip->keys[i+1], &ip->keys[i], sizeof(char*)*(ip->count-i));
+		memmove(&ip->children[i+2], &ip->children[i+1], sizeof(void*)*(ip->count-i));
+		ip->keys[i] = childSep;
+		ip->children[i+1] = childRight;
+		ip->count++;
+		return INSERTED;
+	}
+
+	//puts all INNER_KEYS+1 separators and their children in order, keeps the lower half, moves the middle separator up, and gives the upper half to a new node
+	char *keys[INNER_KEYS+1];
+	void *children[INNER_KEYS+2];
+	memcpy(keys, ip->keys, sizeof(char*)*i);
+	keys[i] = childSep;
+	memcpy(&keys[i+1], &ip->keys[i], sizeof(char*)*(INNER_KEYS-i));
+	memcpy(children, ip->children, sizeof(void*)*(i+1));
+	children[i+1] = childRight;
+	memcpy(&children[i+2], &ip->children[i+1], sizeof(void*)*(INNER_KEYS-i));
+
+	INNER *rp = newInner();
+	int half = (INNER_KEYS+1)/2;
+	ip->count = half;
+	rp->count = INNER_KEYS-half;
+	memcpy(ip->keys, keys, sizeof(char*)*half);
+	memcpy(ip->children, children, sizeof(void*)*(half+1));
+	memcpy(rp->keys, &keys[half+1], sizeof(char*)*rp->count);
+	memcpy(rp->children, &children[half+1], sizeof(void*)*(rp->count+1));
+
+	*sep = keys[half];
+	*right = rp;
+	return SPLIT;
+}
+
+/*Removes separator keys[k] and the child to its right, children[k+1], from inner node ip. The separator itself is not freed.
+ *Big-O notation: O(1)
+ */
+static void removeSeparator(INNER *ip, int k)
+{
+	memmove(&ip->keys[k], &ip->keys[k+1], sizeof(char*)*(ip->count-k-1));
+	memmove(&ip->children[k+1], &ip->children[k+2], sizeof(void*)*(ip->count-k-1));
+	ip->count--;
+}
+
+/*Fixes leaf children[i] of inner node ip after it has dropped below LEAF_MIN strings, either by borrowing a string from a neighboring leaf that has more than it needs, or by merging it with a neighbor. The separators in ip are updated to match.
+ *Big-O notation: O(1)
+ */
+static void fixLeaf(INNER *ip, int i)
+{
+	LEAF *child = ip->children[i];
+	LEAF *left = i > 0 ? ip->children[i-1] : NULL;
+	LEAF *right = i < ip->count ? ip->children[i+1] : NULL;
+
+	if(left != NULL && left->count > LEAF_MIN)
+	{
+		//moves the last string of the left leaf to the front of the child
+		memmove(&child->keys[1], &child->keys[0], sizeof(char*)*child->count);
+		child->keys[0] = left->keys[--left->count];
+		child->count++;
+		ip->keys[i-1] = child->keys[0];
+	}
+	else if(right != NULL && right->count > LEAF_MIN)
+	{
+		//moves the first string of the right leaf to the end of the child
+		child->keys[child->count++] = right->keys[0];
+		memmove(&right->keys[0], &right->keys[1], sizeof(char*)*(--right->count));
+		ip->keys[i] = right->keys[0];
+	}
+	else
+	{
+		//merges the child into the left leaf, or the right leaf into the child, so that the first leaf is never the one removed
+		if(left == NULL)
+		{
+			left = child;
+			child = right;
+			i++;
+		}
+		memcpy(&left->keys[left->count], child->keys, sizeof(char*)*child->count);
+		left->count += child->count;
+		left->next = child->next;
+		free(child);
+		removeSeparator(ip, i-1);
+	}
+}
+
+/*Fixes inner node children[i] of inner node ip after it has dropped below INNER_MIN separators, either by rotating a child through ip from a neighboring node that has more than it needs, or by merging it with a neighbor and the separator between them.
+ *Big-O notation: O(1)
+ */
+static void fixInner(INNER *ip, int i)
+{
+	INNER *child = ip->children[i];
+	INNER *left = i > 0 ? ip->children[i-1] : NULL;
+	INNER *right = i < ip->count ? ip->children[i+1] : NULL;
+
+	if(left != NULL && left->count > INNER_MIN)
+	{
+		//the separator above moves down to the front of the child, and the last separator of the left node takes its place
+		memmove(&child->keys[1], &child->keys[0], sizeof(char*)*child->count);
+		memmove(&child->children[1], &child->children[0], sizeof(void*)*(child->count+1));
+		child->keys[0] = ip->keys[i-1];
+		child->children[0] = left->children[left->count];
+		child->count++;
+		ip->keys[i-1] = left->keys[--left->count];
+	}
+	else if(right != NULL && right->count > INNER_MIN)
+	{
+		//the separator above moves down to the end of the child, and the first separator of the right node takes its place
+		child->keys[child->count] = ip->keys[i];
+		child->children[child->count+1] = right->children[0];
+		child->count++;
+		ip->keys[i] = right->keys[0];
+		right->count--;
+		memmove(&right->keys[0], &right->keys[1], sizeof(char*)*right->count);
+		memmove(&right->children[0], &right->children[1], sizeof(void*)*(right->count+1));
+	}
+	else
+	{
+		//merges the child into the left node, or the right node into the child, with the separator between them moved down
+		if(left == NULL)
+		{
+			left = child;
+			child = right;
+			i++;
+		}
+		left->keys[left->count] = ip->keys[i-1];
+		memcpy(&left->keys[left->count+1], child->keys, sizeof(char*)*child->count);
+		memcpy(&left->children[left->count+1], child->children, sizeof(void*)*(child->count+1));
+		left->count += child->count+1;
+		free(child);
+		removeSeparator(ip, i-1);
+	}
+}
+
+/*Removes elt from the subtree rooted at node, which has height levels of inner nodes above its leaves, fixing any child that is left with too few entries on the way back up. Returns whether elt was found.
+ *Big-O notation: O(log(n))
+ */
+static bool removeKey(void *node, int height, char *elt)
+{
+	if(height == 0)
+	{
+		LEAF *lp = node;
+		bool found;
+		int pos = searchLeaf(lp, elt, &found);
+		if(!found)
+		{
+			return false;
+		}
+		memmove(&lp->keys[pos], &lp->keys[pos+1], sizeof(char*)*(lp->count-pos-1));
+		lp->count--;
+		return true;
+	}
+
+	INNER *ip = node;
+	int i = searchInner(ip, elt);
+	if(!removeKey(ip->children[i], height-1, elt))
+	{
+		return false;
+	}
+
+	if(height == 1)
+	{
+		if(((LEAF*)ip->children[i])->count < LEAF_MIN)
+		{
+			fixLeaf(ip, i);
+		}
+	}
+	else if(((INNER*)ip->children[i])->count < INNER_MIN)
+	{
+		fixInner(ip, i);
+	}
+	return true;
+}
+
+/*Frees the nodes of the subtree rooted at node, which has height levels of inner nodes above its leaves. The strings are left to be freed with the arena.
+ *Big-O notation: O(n)
+ */
+static void freeTree(void *node, int height)
+{
+	int i;
+	if(height == 0)
+	{
+		free(node);
+		return;
+	}
+
+	INNER *ip = node;
+	for(i = 0; i <= ip->count; i++)
+	{
+		freeTree(ip->children[i], height-1);
+	}
+	free(ip);
+}
+
+/*Creates the set, taking in an argument maxElts that represents the maximum number of words that can be stored in the set. The tree starts out as a single empty leaf. Assert is used to make sure that none of the pointers used are null.
+ *Big-O notation: O(1)
+ */
+SET *createSet(int maxElts)
+{
+	SET *setptr = malloc(sizeof(SET));
+	assert(setptr != NULL);
+	setptr->first = newLeaf();
+	setptr->root = setptr->first;
+	setptr->arena = createArena(true);
+	setptr->height = 0;
+	setptr->length = maxElts;
+	setptr->count = 0;
+	return setptr;
+}
+
+/*Creates a set holding the n strings in elts, taking in maxElts the same way as createSet. The strings are sorted once and the first of each run of equal strings is copied into the arena, and then the tree is built from the bottom up: the copies are spread evenly over as few leaves as will hold them, and each level of inner nodes is built over the level below it the same way, with each node's separators taken from the first strings of its children. The strings in elts still belong to the caller, and the array elts itself is only sorted in place.
+ *Big-O notation: O(n log(n))
+ */
+SET *createSetFrom(int maxElts, char **elts, int n)
+{
+	assert(elts != NULL || n == 0);
+	SET *setptr = createSet(maxElts);
+	qsort(elts, n, sizeof(char*), compareStrings);
+
+	int i, j, k, count = 0;
+	char **copies = malloc(sizeof(char*)*(n+1));
+	assert(copies != NULL);
+	//after sorting, equal strings are next to each other, so only the first of each run is kept
+	for(i = 0; i < n; i++)
+	{
+		if(i == 0 || strcmp(elts[i-1], elts[i]) != 0)
+		{
+			copies[count++] = copyArena(setptr->arena, elts[i], strlen(elts[i]));
+		}
+	}
+	assert(count <= setptr->length);
+	setptr->count = count;
+	if(count == 0)
+	{
+		free(copies);
+		return setptr;
+	}
+
+	//builds the leaves, keeping the first string of each to use as a separator above it
+	int m = (count + LEAF_KEYS - 1) / LEAF_KEYS;
+	void **nodes = malloc(sizeof(void*)*m);
+	char **mins = malloc(sizeof(char*)*m);
+	assert(nodes != NULL && mins != NULL);
+	LEAF *lp = setptr->first;
+	for(i = 0; i < m; i++)
+	{
+		if(i > 0)
+		{
+			lp->next = newLeaf();
+			lp = lp->next;
+		}
+		lp->count = (long)(i+1)*count/m - (long)i*count/m;
+		memcpy(lp->keys, &copies[(long)i*count/m], sizeof(char*)*lp->count);
+		nodes[i] = lp;
+		mins[i] = lp->keys[0];
+	}
+
+	//builds each level of inner nodes over the level below until only the root is left
+	while(m > 1)
+	{
+		int parents = (m + INNER_KEYS) / (INNER_KEYS+1);
+		for(i = 0; i < parents; i++)
+		{
+			INNER *ip = newInner();
+			int start = (long)i*m/parents;
+			int end = (long)(i+1)*m/parents;
+			for(j = start, k = 0; j < end; j++, k++)
+			{
+				ip->children[k] = nodes[j];
+				if(k > 0)
+				{
+					ip->keys[k-1] = mins[j];
+				}
+			}
+			ip->count = end-start-1;
+			nodes[i] = ip;
+			mins[i] = mins[start];
+		}
+		m = parents;
+		setptr->height++;
+	}
+
+	setptr->root = nodes[0];
+	free(copies);
+	free(nodes);
+	free(mins);
+	return setptr;
+}
+
+/*Deallocates memory from inputted set sp, freeing every node of the tree, then every string at once by destroying the arena, and then the set sp itself. Assert is used to make sure none of the pointers used are null.
+ *Big-O notation: O(n)
+ */
+void destroySet(SET *sp)
+{
+	assert(sp != NULL);
+	freeTree(sp->root, sp->height);
+	destroyArena(sp->arena);
+	free(sp);
+}
+
+/*Finds and returns the number of elements currently stored in the set by accessing the variable count. Assert is used to make sure none of the pointers used are null.
+ *Big-O notation: O(1)
+ */
+int numElements(SET *sp)
+{
+	assert(sp != NULL);
+	return sp->count;
+}
+
+/*Adds an inputted string elt into set sp, in the correct alphabetical order. Measures elt and passes it to addElementLen. Assert is used to make sure none of the pointers used are null.
+ *Big-O notation: O(log(n))
+ */
+void addElement(SET *sp, char *elt)
+{
+	assert(elt != NULL);
+	addElementLen(sp, elt, strlen(elt));
+}
+
+/*Same as addElement, but takes the length of elt from the caller so that the copy in the arena can be made without measuring elt again. If the root splits, a new root is made above the two halves, which is the only way the tree grows taller. Assert is used to make sure none of the pointers used are null and that the set is not already holding its maximum number of elements.
+ *Big-O notation: O(log(n))
+ */
+void addElementLen(SET *sp, char *elt, int length)
+{
+	assert(sp != NULL);
+	assert(elt != NULL);
+
+	char *sep;
+	void *right;
+	int result = insert(sp->root, sp->height, sp->arena, elt, length, &sep, &right);
+	if(result == DUPLICATE)
+	{
+		return;
+	}
+
+	sp->count++;
+	assert(sp->count <= sp->length);
+	if(result == SPLIT)
+	{
+		INNER *root = newInner();
+		root->count = 1;
+		root->keys[0] = sep;
+		root->children[0] = sp->root;
+		root->children[1] = right;
+		sp->root = root;
+		sp->height++;
+	}
+}
+
+/*Removes inputted string elt from the set sp if it is there. If the root is left with a single child, that child becomes the new root, which is the only way the tree grows shorter. Assert is used to make sure none of the pointers used are null.
+ *Big-O notation: O(log(n))
+ */
+void removeElement(SET *sp, char *elt)
+{
+	assert(sp != NULL);
+	assert(elt != NULL);
+	if(!removeKey(sp->root, sp->height, elt))
+	{
+		return;
+	}
+
+	sp->count--;
+	if(sp->height > 0 && ((INNER*)sp->root)->count == 0)
+	{
+		INNER *old = sp->root;
+		sp->root = old->children[0];
+		sp->height--;
+		free(old);
+	}
+}
+
+/*Same as removeElement. The length of elt isn't needed to search the tree, but is accepted so callers can use the same entry points for every implementation.
+ *Big-O notation: O(log(n))
+ */
+void removeElementLen(SET *sp, char *elt, int length)
+{
+	removeElement(sp, elt);
+}
+
+/*Finds inputted string elt in set sp by following the separators down to the leaf it belongs in, and returns the matching string, or null if it is not in the set.
+ *Big-O notation: O(log(n))
+ */
+char *findElement(SET *sp, char *elt)
+{
+	assert(sp != NULL);
+	assert(elt != NULL);
+	void *node = sp->root;
+	int height;
+	for(height = sp->height; height > 0; height--)
+	{
+		INNER *ip = node;
+		node = ip->children[searchInner(ip, elt)];
+	}
+
+	bool found;
+	LEAF *lp = node;
+	int pos = searchLeaf(lp, elt, &found);
+	return found ? lp->keys[pos] : NULL;
+}
+
+/*Same as findElement. The length of elt isn't needed to search the tree, but is accepted so callers can use the same entry points for every implementation.
+ *Big-O notation: O(log(n))
+ */
+char *findElementLen(SET *sp, char *elt, int length)
+{
+	return findElement(sp, elt);
+}
+
+/*Adds a copy of every string in set other to set sp, walking the leaves of other in order and adding each string with addElement.
+ *Big-O notation: O(m log(n+m))
+ */
+void unionSet(SET *sp, SET *other)
+{
+	assert(sp != NULL && other != NULL);
+	int i;
+	LEAF *lp;
+	for(lp = other->first; lp != NULL; lp = lp->next)
+	{
+		for(i = 0; i < lp->count; i++)
+		{
+			addElement(sp, lp->keys[i]);
+		}
+	}
+}
+
+/*Removes every string in set other from set sp, walking the leaves of other in order and removing each string with removeElement.
+ *Big-O notation: O(m log(n))
+ */
+void differenceSet(SET *sp, SET *other)
+{
+	assert(sp != NULL && other != NULL);
+	int i;
+	LEAF *lp;
+	for(lp = other->first; lp != NULL; lp = lp->next)
+	{
+		for(i = 0; i < lp->count; i++)
+		{
+			removeElement(sp, lp->keys[i]);
+		}
+	}
+}
+
+/*Removes every string that is not also in set other from set sp. The strings to remove are gathered from the leaves of sp first, since removing them changes the leaves.
+ *Big-O notation: O(n log(n+m))
+ */
+void intersectSet(SET *sp, SET *other)
+{
+	assert(sp != NULL && other != NULL);
+	char **elts = getElements(sp);
+	int i, n = sp->count;
+	for(i = 0; i < n; i++)
+	{
+		if(findElement(other, elts[i]) == NULL)
+		{
+			removeElement(sp, elts[i]);
+		}
+	}
+	free(elts);
+}
+
+/*Returns the number of strings in set sp that are less than elt. The nodes don't keep counts of the strings below them, so the leaves are walked in order from the first one, stopping at the first string not less than elt.
+ *Big-O notation: O(n)
+ */
+int rankElement(SET *sp, char *elt)
+{
+	assert(sp != NULL);
+	assert(elt != NULL);
+	int i, rank = 0;
+	LEAF *lp;
+	for(lp = sp->first; lp != NULL; lp = lp->next)
+	{
+		for(i = 0; i < lp->count; i++)
+		{
+			if(strcmp(lp->keys[i], elt) >= 0)
+			{
+				return rank;
+			}
+			rank++;
+		}
+	}
+	return rank;
+}
+
+/*Returns the string of rank k in set sp, meaning the one with k strings less than it, by walking the leaves in order and skipping whole leaves until the one holding it. Assert is used to make sure k is in range.
+ *Big-O notation: O(n)
+ */
+char *selectElement(SET *sp, int k)
+{
+	assert(sp != NULL);
+	assert(k >= 0 && k < sp->count);
+	LEAF *lp = sp->first;
+	while(k >= lp->count)
+	{
+		k -= lp->count;
+		lp = lp->next;
+	}
+	return lp->keys[k];
+}
+
+/*Returns the number of strings in set sp that are not less than lo and less than hi, and stores the rank of the first of them in first. Either bound may be null to leave that end of the range open. Both ranks are found with rankElement.
+ *Big-O notation: O(n)
+ */
+int findRange(SET *sp, char *lo, char *hi, int *first)
+{
+	assert(sp != NULL);
+	assert(first != NULL);
+	int low = lo != NULL ? rankElement(sp, lo) : 0;
+	int high = hi != NULL ? rankElement(sp, hi) : sp->count;
+	*first = low;
+	return high > low ? high - low : 0;
+}
+
+/*Returns the number of strings in set sp that start with prefix, and stores the rank of the first of them in first. The strings that start with prefix are all next to each other, starting at the first string not less than prefix, so the leaves are walked in order until the first one after them.
+ *Big-O notation: O(n)
+ */
+int findPrefix(SET *sp, char *prefix, int *first)
+{
+	assert(sp != NULL);
+	assert(prefix != NULL);
+	assert(first != NULL);
+	int i, below = 0, count = 0;
+	int length = strlen(prefix);
+	LEAF *lp;
+	for(lp = sp->first; lp != NULL; lp = lp->next)
+	{
+		for(i = 0; i < lp->count; i++)
+		{
+			if(strncmp(lp->keys[i], prefix, length) == 0)
+			{
+				count++;
+			}
+			else if(count > 0 || strcmp(lp->keys[i], prefix) > 0)
+			{
+				*first = below;
+				return count;
+			}
+			else
+			{
+				below++;
+			}
+		}
+	}
+	*first = below;
+	return count;
+}
+
+/*Does nothing, since only the sorted array in sorted.c is front coded. Kept so callers can use the same entry points for every implementation.
+ *Big-O notation: O(1)
+ */
+void compressSet(SET *sp)
+{
+	assert(sp != NULL);
+}
+
+/*Does nothing, since freezing only changes the layout of the sorted array in sorted.c. Kept so callers can use the same entry points for every implementation.
+ *Big-O notation: O(1)
+ */
+void freezeSet(SET *sp)
+{
+	assert(sp != NULL);
+}
+
+/*Returns a new array holding every string in the set in alphabetical order, found by walking the linked leaves from the first one.
+ *Big-O notation: O(n)
+ */
+char **getElements(SET *sp)
+{
+	assert(sp != NULL);
+	char **newData = malloc(sizeof(char*)*sp->count);
+	assert(newData != NULL || sp->count == 0);
+
+	int i = 0;
+	LEAF *lp;
+	for(lp = sp->first; lp != NULL; lp = lp->next)
+	{
+		memcpy(&newData[i], lp->keys, sizeof(char*)*lp->count);
+		i += lp->count;
+	}
+	return newData;
+}
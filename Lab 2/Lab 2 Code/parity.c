@@ -9,18 +9,25 @@
  *              The program takes a single file as a command line argument.
  *              A set is used to maintain a collection of words that occur
  *              an odd number of times.  The counts of total words and
- *              words appearing an odd number of times are printed.
+ *              words appearing an odd number of times are printed.  With
+ *              -f, words are lowercased and stripped of surrounding
+ *              punctuation first.
  */
 
 # include <stdio.h>
 # include <stdlib.h>
 # include <string.h>
+# include <stdbool.h>
 # include "set.h"
+# include "token.h"
 
 
-/* This is sufficient for the test cases in /scratch/coen12. */
+/* This is sufficient for the test cases in /scratch/coen12.  Larger inputs
+   can be run by compiling with -DMAX_SIZE=n. */
 
+# ifndef MAX_SIZE
 # define MAX_SIZE 18000
+# endif
 
 
 /*
@@ -31,42 +38,51 @@
 
 int main(int argc, char *argv[])
 {
-    FILE *fp;
-    char buffer[BUFSIZ];
+    TOKENIZER *tp;
+    char *word;
     SET *odd;
-    int words;
+    int words, length;
+    bool fflag = false;
 
 
     /* Check usage and open the file. */
 
+    if (argc == 3 && strcmp(argv[1], "-f") == 0) {
+	fflag = true;
+	argc --;
+	argv[1] = argv[2];
+    }
+
     if (argc != 2) {
-        fprintf(stderr, "usage: %s file1\n", argv[0]);
+        fprintf(stderr, "usage: %s [-f] file1\n", argv[0]);
         exit(EXIT_FAILURE);
     }
 
-    if ((fp = fopen(argv[1], "r")) == NULL) {
+    if ((tp = openTokenizer(argv[1])) == NULL) {
         fprintf(stderr, "%s: cannot open %s\n", argv[0], argv[1]);
         exit(EXIT_FAILURE);
     }
 
+    foldTokens(tp, fflag);
+
 
     /* Insert or delete words to compute their parity. */
 
     words = 0;
     odd = createSet(MAX_SIZE);
 
-    while (fscanf(fp, "%s", buffer) == 1) {
+    while ((word = nextToken(tp, &length)) != NULL) {
         words ++;
 
-        if (findElement(odd, buffer))
-            removeElement(odd, buffer);	
+        if (findElementLen(odd, word, length))
+            removeElementLen(odd, word, length);
         else
-            addElement(odd, buffer);
+            addElementLen(odd, word, length);
     }
 
     printf("%d total words\n", words);
     printf("%d words occur an odd number of times\n", numElements(odd));
-    fclose(fp);
+    closeTokenizer(tp);
 
     destroySet(odd);
     exit(EXIT_SUCCESS);
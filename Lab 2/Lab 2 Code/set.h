@@ -6,6 +6,49 @@
  * Description: This file contains the public function and type
  *              declarations for a set abstract data type for strings.  A
  *              set is an unordered collection of distinct elements.
+ *
+ *              The Len versions of addElement, removeElement, and
+ *              findElement take the length of ELT from the caller (such
+ *              as a tokenizer that already knows it) so the string does
+ *              not have to be measured again.
+ *
+ *              createSetFrom builds a set from a whole array of strings at
+ *              once, which is faster than adding them one at a time.  The
+ *              set copies the strings it keeps, so the strings still belong
+ *              to the caller, and the order of the array may be changed.
+ *
+ *              The set keeps its copies of the strings in an arena, so a
+ *              string returned by the set stays valid until the set is
+ *              destroyed or compressed, even if it is removed.
+ *
+ *              freezeSet tells the set that it is about to be searched
+ *              far more than it is changed, so that it can rearrange
+ *              itself for faster lookups.  compressSet similarly lets the
+ *              set trade some speed for less memory.  A frozen or
+ *              compressed set still supports every operation, but the
+ *              string returned by findElement for a compressed set may
+ *              only be valid until the next call.
+ *
+ *              unionSet, differenceSet, and intersectSet change the first
+ *              set to be its union, difference, or intersection with the
+ *              second set, which is left as it was.
+ *
+ *              rankElement, selectElement, findRange, and findPrefix treat
+ *              the set as if its elements were in alphabetical order.  The
+ *              rank of a string is the number of elements less than it,
+ *              and selectElement returns the element of a given rank.
+ *              findRange and findPrefix return how many elements lie in a
+ *              range or start with a prefix and store the rank of the
+ *              first one, so that they can be walked with selectElement
+ *              without copying them.  Either bound of findRange may be
+ *              NULL to leave that end open.  These are fast only for the
+ *              sorted set, where they also work on a frozen or compressed
+ *              set without changing its layout, although the string
+ *              returned by selectElement for a compressed set may only be
+ *              valid until the next call.  The other implementations take
+ *              linear time, except that the unsorted set sorts a copy of
+ *              its elements on the first call to selectElement after each
+ *              change, and answers later calls from that copy.
  */
 
 # ifndef SET_H
@@ -15,6 +58,8 @@ typedef struct set SET;
 
 SET *createSet(int maxElts);
 
+SET *createSetFrom(int maxElts, char **elts, int n);
+
 void destroySet(SET *sp);
 
 int numElements(SET *sp);
@@ -27,4 +72,28 @@ char *findElement(SET *sp, char *elt);
 
 char **getElements(SET *sp);
 
+void freezeSet(SET *sp);
+
+void compressSet(SET *sp);
+
+void unionSet(SET *sp, SET *other);
+
+void differenceSet(SET *sp, SET *other);
+
+void intersectSet(SET *sp, SET *other);
+
+int rankElement(SET *sp, char *elt);
+
+char *selectElement(SET *sp, int k);
+
+int findRange(SET *sp, char *lo, char *hi, int *first);
+
+int findPrefix(SET *sp, char *prefix, int *first);
+
+void addElementLen(SET *sp, char *elt, int length);
+
+void removeElementLen(SET *sp, char *elt, int length);
+
+char *findElementLen(SET *sp, char *elt, int length);
+
 # endif /* SET_H */
@@ -7,17 +7,54 @@
 #include <string.h>
 #include <assert.h>
 #include "set.h"
+#include "arena.h"
 #include <stdbool.h>
+#include <limits.h>
+#include <stdint.h>
+
+#define BLOCK_KEYS 16
 
 
 static int search(SET *sp, char *elt, bool *found);
 
-//definition of the structure set
+static void thawSet(SET *sp);
+
+static int searchTree(SET *sp, char *elt);
+
+static int searchBlocks(SET *sp, char *elt);
+
+static int findBlock(SET *sp, char *elt);
+
+static char *decodeNext(SET *sp, char *p);
+
+static int treePosition(SET *sp, int k);
+
+static void removeAt(SET *sp, int i);
+
+static void expandBlocks(SET *sp);
+
+static void fillKeys(SET *sp);
+
+static uint64_t makeKey(char *elt);
+
+//definition of the structure set. The strings themselves are all copied into arena, which interns them so that a string that is removed and added again reuses its old copy, and which frees them all at once when the set is destroyed. keys[i] holds the first 8 bytes of data[i] packed into an integer, so that most steps of a search compare integers instead of strings. While the set is frozen, the strings are also held in tree, in Eytzinger order starting at index 1, and data and keys are left as they were so they still give the sorted order. While it is compressed, they are held front-coded in blob instead, with heads holding the offset of the first string of each block and scratch holding the last string decoded. In either case, size is the number of strings held, removed marks the ones that have been removed since by their index in sorted order, and the strings are split into blocks of BLOCK_KEYS in sorted order, with ranks[b] holding how many strings before block b have not been removed.
 typedef struct set
 {
 	char **data;
+	uint64_t *keys;
+	ARENA *arena;
 	int length;
 	int count;
+	char **tree;
+	bool *removed;
+	int size;
+	bool frozen;
+	char *blob;
+	int *heads;
+	int blocks;
+	char *scratch;
+	bool compressed;
+	int *ranks;
 }SET;
 
 
@@ -30,23 +67,71 @@ SET *createSet(int maxElts)
         assert(setptr != NULL);
         setptr->length = maxElts;
         setptr->data = malloc(sizeof(char*)*maxElts);
-        assert(setptr->data != NULL);
+        setptr->keys = malloc(sizeof(uint64_t)*maxElts);
+        assert(setptr->data != NULL && setptr->keys != NULL);
+        setptr->arena = createArena(true);
         setptr->count = 0;
+        setptr->tree = NULL;
+        setptr->removed = NULL;
+        setptr->size = 0;
+        setptr->frozen = false;
+        setptr->blob = NULL;
+        setptr->heads = NULL;
+        setptr->blocks = 0;
+        setptr->scratch = NULL;
+        setptr->compressed = false;
+        setptr->ranks = NULL;
         return setptr;
 }
 
-/*Deallocates memory from inputted set sp, first freeing every memory location in data and then freeing the memory of the set sp itself. Assert is used to make sure none of the pointers used are null.
- * Big-O notation: O(n)
+/*Compares the two strings pointed to by p and q, for sorting an array of strings with qsort.
+ *Big-O notation: O(1)
+ */
+static int compareStrings(const void *p, const void *q)
+{
+	return strcmp(*(char **)p, *(char **)q);
+}
+
+/*Creates a set holding the n strings in elts, taking in maxElts the same way as createSet. The strings are sorted once and then copied into data in order, skipping any string equal to the one before it, instead of shifting data for every insertion as addElement does. The strings in elts still belong to the caller, and the array elts itself is only sorted in place. Assert is used to make sure none of the pointers used are null and that the strings fit.
+ *Big-O notation: O(n log(n))
+ */
+SET *createSetFrom(int maxElts, char **elts, int n)
+{
+	assert(elts != NULL || n == 0);
+	SET *setptr = createSet(maxElts);
+	qsort(elts, n, sizeof(char*), compareStrings);
+
+	int i;
+	//after sorting, equal strings are next to each other, so only the first of each run is kept
+	for(i = 0; i < n; i++)
+	{
+		if(setptr->count > 0 && strcmp(setptr->data[setptr->count-1], elts[i]) == 0)
+		{
+			continue;
+		}
+		assert(setptr->count < setptr->length);
+		setptr->data[setptr->count++] = copyArena(setptr->arena, elts[i], strlen(elts[i]));
+	}
+	fillKeys(setptr);
+	return setptr;
+}
+
+/*Deallocates memory from inputted set sp, freeing every string at once by destroying the arena, then the arrays used by whichever of the sorted, frozen, or compressed layouts the set is in, and then the memory of the set sp itself. Assert is used to make sure none of the pointers used are null.
+ * Big-O notation: O(1)
  */
 void destroySet(SET *sp)
 {
         assert(sp != NULL);
-        int i;
-        //Goes through every element in the array data and frees the memory of each element. Memory of sp is freed afterwards since sp is needed to access the array data.  
-        for(i = 0; i < sp->count; i++)
-        {
-        	free(sp->data[i]);  
-        }
+        destroyArena(sp->arena);
+        //any of these may be null depending on the layout, which free allows
+        free(sp->data);
+        free(sp->keys);
+        free(sp->tree);
+        free(sp->removed);
+        free(sp->blob);
+        free(sp->heads);
+        free(sp->scratch);
+        free(sp->ranks);
         free(sp);                                                                               
 }
 
@@ -59,15 +144,25 @@ int numElements(SET *sp)
         return sp->count;
 }
 
-/*Adds an inputted string elt into the array data of set sp, in the correct alphabetical order. Will prevent elt from being added to the array if the array data is already holding its maximum number of elements, or if the value of elt is already present in the array. Assert is used to make sure none of the pointers used are null.
+/*Adds an inputted string elt into the array data of set sp, in the correct alphabetical order. Will prevent elt from being added to the array if the array data is already holding its maximum number of elements, or if the value of elt is already present in the array. Measures elt and passes it to addElementLen. Assert is used to make sure none of the pointers used are null.
  *Big-O notation: O(n)
  */
 void addElement(SET *sp, char *elt)
+{
+	assert(elt != NULL);
+	addElementLen(sp, elt, strlen(elt));
+}
+
+/*Same as addElement, but takes the length of elt from the caller so that the copy in the arena can be made without measuring elt again. A frozen or compressed set is thawed first. Assert is used to make sure none of the pointers used are null.
+ *Big-O notation: O(n)
+ */
+void addElementLen(SET *sp, char *elt, int length)
 {
         assert(sp != NULL);
         assert(elt != NULL);
         //checks to see if the set is already holding the maximum number of strings
         assert(sp->count <= sp->length);
+	thawSet(sp);
 	
 	bool found;
 	int elementIndex = search(sp, elt, &found);
@@ -79,24 +174,35 @@ void addElement(SET *sp, char *elt)
 	
 	int i;
 	//shifts every value between the end of the array and element index so that the new element can be put into the array correctly
-	for(i = sp->count; i >= elementIndex; i--)
+	for(i = sp->count; i > elementIndex; i--)
 	{	
 		sp->data[i] = sp->data[i-1];
+		sp->keys[i] = sp->keys[i-1];
 	}
-	//Adds elt to the array data by using strdup at correct alphabetical order location elementIndex. 
-	sp->data[elementIndex] = strdup(elt);
-     	assert(sp->data[elementIndex] != NULL);
+	//Adds a copy of elt to the array data at correct alphabetical order location elementIndex. 
+	sp->data[elementIndex] = copyArena(sp->arena, elt, length);
+	sp->keys[elementIndex] = makeKey(elt);
 	sp->count++;
 }
 
-
-/*Removes inputted string elt from the set sp. Makes sure that elt exists in the set first before removing. Assert is used to make sure none of the pointers used are null.  
+/*Removes inputted string elt from the set sp. Makes sure that elt exists in the set first before removing. If the set is frozen or compressed, elt is marked as removed instead and dropped when the set is thawed, and ranks is updated for the blocks after it. Assert is used to make sure none of the pointers used are null.  
  *Big-O notation: O(n)
  */
 void removeElement(SET *sp, char *elt)
 {
         assert(sp != NULL);
         assert(elt != NULL);
+	//while frozen or compressed, elt is only marked as removed, since the tree still needs it for comparisons until the set is thawed
+	if(sp->frozen || sp->compressed)
+	{
+		int k = sp->frozen ? searchTree(sp, elt) : searchBlocks(sp, elt);
+		if(k != -1)
+		{
+			removeAt(sp, sp->frozen ? treePosition(sp, k) : k);
+		}
+		return;
+	}
+
         bool found;
 	int elementIndex = search(sp, elt, &found);
         //checks to see if elt is in the set, ending the funciton if it is not in the set
@@ -105,43 +211,734 @@ void removeElement(SET *sp, char *elt)
         	return;
         }
 	
-	//frees the memory of the element at elementIndex to prevent a memory leak
-	free(sp->data[elementIndex]);
+	//the string itself stays in the arena until the set is destroyed
 	//starting at elementIndex, sets each value in the array equal to the value ahead of it
 	int i;
 	for(i = elementIndex; i < sp->count-1; i++)
 	{
 		sp->data[i] = sp->data[i+1];	
+		sp->keys[i] = sp->keys[i+1];
 	}
 	sp->count--;
 }
 
-/*Finds inputted string elt in set sp. Uses search function to find the matching string, and then returns that string. 
+/*Same as removeElement. The length of elt isn't needed for a binary search, but is accepted so callers can use the same entry points for every implementation.
+ *Big-O notation: O(n)
+ */
+void removeElementLen(SET *sp, char *elt, int length)
+{
+	removeElement(sp, elt);
+}
+
+/*Finds inputted string elt in set sp. Uses search function to find the matching string, or searchTree if the set is frozen, and then returns that string. If the set is compressed, searchBlocks decodes the string into scratch instead, so the string returned is only valid until the next call. 
  *Big-O notation: O(log(n))
  */
 char *findElement(SET *sp, char *elt)
 {
         assert(sp != NULL);
         assert(elt != NULL);
+	if(sp->frozen)
+	{
+		int k = searchTree(sp, elt);
+		return (k != -1 && !sp->removed[treePosition(sp, k)]) ? sp->tree[k] : NULL;
+	}
+	if(sp->compressed)
+	{
+		int k = searchBlocks(sp, elt);
+		return (k != -1 && !sp->removed[k]) ? sp->scratch : NULL;
+	}
+
 	bool found; 
         int elementIndex = search(sp, elt, &found);
         //checks if string exists in the set, and returns null if string isn't found in the set
         return found ? sp->data[elementIndex] : NULL;
 }
 
-/*Creates a copy of array data and returns the new array. All values in data are the same in the newData array.
+/*Same as findElement. The length of elt isn't needed for a binary search, but is accepted so callers can use the same entry points for every implementation.
+ *Big-O notation: O(log(n))
+ */
+char *findElementLen(SET *sp, char *elt, int length)
+{
+	return findElement(sp, elt);
+}
+
+/*Creates a copy of array data and returns the new array. All values in data are the same in the newData array. A frozen set still has its strings in data, so the ones that haven't been removed are copied from there and the set stays frozen. A compressed set has no separate copies of its strings to return, so it is thawed first, which decodes every string and leaves the set sorted instead of compressed.
  *Big-O notation: O(n)
  */
 char **getElements(SET *sp)
 {
         assert(sp != NULL);
-        //allocates memory to the new array and copies every value from the array data into the new array newData on the next line
+        //allocates memory to the new array and copies every value from the array data into the new array newData
         char **newData = malloc(sizeof(char*)*sp->count);
 	assert(newData != NULL);
+	if(sp->frozen)
+	{
+		int i, next = 0;
+		for(i = 0; i < sp->size; i++)
+		{
+			if(!sp->removed[i])
+			{
+				newData[next++] = sp->data[i];
+			}
+		}
+		return newData;
+	}
+        thawSet(sp);
         memcpy(newData, sp->data, sizeof(char*)*sp->count);
 	return newData;
 }
-/*Searches the array data in the set sp for a given element elt. Returns the index elt is located at, or the index where it should be located in the array based off of its alphabetical ordering. Uses a boolean value passed in by reference to indicate whether the returned value is the index of the element, or the index of where the element should be located. Uses binary search since array is sorted.  
+/*Returns the index of the first string in array that is not less than elt, searching from index low up to n. Gallops ahead by 1, 2, 4, 8, and so on until a string not less than elt is passed, and then uses binary search over the last gap, so the cost depends on how far ahead the answer is rather than on n. This makes merging two sets cheap when one is much smaller than the other, since long runs of the larger one are skipped in a few steps.
+ *Big-O notation: O(log(k)) where k is the distance from low to the answer
+ */
+static int gallop(char **array, int low, int n, char *elt)
+{
+	int step = 1;
+	int high = low;
+	//finds a gap (low, high] that holds the answer
+	while(high < n && strcmp(array[high], elt) < 0)
+	{
+		low = high + 1;
+		high += step;
+		step *= 2;
+	}
+	if(high > n)
+	{
+		high = n;
+	}
+
+	//binary search for the first string not less than elt in [low, high)
+	while(low < high)
+	{
+		int mid = (low+high)/2;
+		if(strcmp(array[mid], elt) < 0)
+		{
+			low = mid + 1;
+		}
+		else
+		{
+			high = mid;
+		}
+	}
+	return low;
+}
+
+/*Adds a copy of every string in set other to set sp, by merging the two sorted arrays into a new array in one pass and then replacing data with it. Strings that are only in sp are moved rather than copied, and runs of strings that are only in one of the sets are skipped over by galloping. Both sets are thawed first if they are frozen or compressed. Assert is used to make sure none of the pointers used are null and that the strings fit.
+ *Big-O notation: O(n + m)
+ */
+void unionSet(SET *sp, SET *other)
+{
+	assert(sp != NULL && other != NULL);
+	thawSet(sp);
+	thawSet(other);
+	char **merged = malloc(sizeof(char*)*sp->length);
+	assert(merged != NULL);
+
+	int i = 0, j = 0, k, count = 0, length;
+	while(i < sp->count || j < other->count)
+	{
+		int result = i == sp->count ? 1 : j == other->count ? -1 : strcmp(sp->data[i], other->data[j]);
+		if(result < 0)
+		{
+			//moves the run of strings in sp that come before the next string of other
+			k = j == other->count ? sp->count : gallop(sp->data, i, sp->count, other->data[j]);
+			assert(count + k - i <= sp->length);
+			memcpy(&merged[count], &sp->data[i], sizeof(char*)*(k-i));
+			count += k - i;
+			i = k;
+		}
+		else if(result > 0)
+		{
+			//copies the run of strings in other that come before the next string of sp
+			k = i == sp->count ? other->count : gallop(other->data, j, other->count, sp->data[i]);
+			for(; j < k; j++)
+			{
+				assert(count < sp->length);
+				length = strlen(other->data[j]);
+				merged[count++] = copyArena(sp->arena, other->data[j], length);
+			}
+		}
+		else
+		{
+			merged[count++] = sp->data[i++];
+			j++;
+		}
+	}
+
+	free(sp->data);
+	sp->data = merged;
+	sp->count = count;
+	fillKeys(sp);
+}
+
+/*Removes every string in set other from set sp in one pass over the two sorted arrays, sliding the strings that are kept down over the ones that are dropped. Runs of strings that are only in one of the sets are skipped over by galloping, so removing a few strings from a large set or many strings from a small one is cheap. Both sets are thawed first if they are frozen or compressed. Assert is used to make sure none of the pointers used are null.
+ *Big-O notation: O(n + m)
+ */
+void differenceSet(SET *sp, SET *other)
+{
+	assert(sp != NULL && other != NULL);
+	thawSet(sp);
+	thawSet(other);
+
+	int i = 0, j = 0, k, count = 0;
+	while(i < sp->count)
+	{
+		int result = j == other->count ? -1 : strcmp(sp->data[i], other->data[j]);
+		if(result < 0)
+		{
+			//keeps the run of strings in sp that come before the next string of other
+			k = j == other->count ? sp->count : gallop(sp->data, i, sp->count, other->data[j]);
+			memmove(&sp->data[count], &sp->data[i], sizeof(char*)*(k-i));
+			count += k - i;
+			i = k;
+		}
+		else if(result > 0)
+		{
+			j = gallop(other->data, j, other->count, sp->data[i]);
+		}
+		else
+		{
+			i++;
+			j++;
+		}
+	}
+	sp->count = count;
+	fillKeys(sp);
+}
+
+/*Removes every string that is not also in set other from set sp in one pass over the two sorted arrays, sliding the strings that are kept down over the ones that are dropped. Runs of strings that are only in one of the sets are skipped over by galloping. Both sets are thawed first if they are frozen or compressed. Assert is used to make sure none of the pointers used are null.
+ *Big-O notation: O(n + m)
+ */
+void intersectSet(SET *sp, SET *other)
+{
+	assert(sp != NULL && other != NULL);
+	thawSet(sp);
+	thawSet(other);
+
+	int i = 0, j = 0, count = 0;
+	while(i < sp->count)
+	{
+		int result = j == other->count ? -1 : strcmp(sp->data[i], other->data[j]);
+		if(result < 0)
+		{
+			//drops the run of strings in sp that come before the next string of other
+			i = j == other->count ? sp->count : gallop(sp->data, i, sp->count, other->data[j]);
+		}
+		else if(result > 0)
+		{
+			j = gallop(other->data, j, other->count, sp->data[i]);
+		}
+		else
+		{
+			sp->data[count++] = sp->data[i++];
+			j++;
+		}
+	}
+	sp->count = count;
+	fillKeys(sp);
+}
+
+/*Returns the block of set sp holding the string of rank k, which is the last block whose count in ranks of strings before it is not more than k. Uses binary search over ranks.
+ *Big-O notation: O(log(n))
+ */
+static int findRankBlock(SET *sp, int k)
+{
+	int low = 0;
+	int high = sp->blocks - 1;
+	int mid, block = 0;
+	while(low <= high)
+	{
+		mid = (low+high)/2;
+		if(sp->ranks[mid] <= k)
+		{
+			block = mid;
+			low = mid + 1;
+		}
+		else
+		{
+			high = mid - 1;
+		}
+	}
+	return block;
+}
+
+/*Returns the number of strings in set sp that are less than elt, which is also the index elt is located at, or would be located at, in the sorted array data. If the set is frozen, search still works on data, and the strings removed since it was frozen are taken away by starting from ranks for the block of that index and counting the rest of the block up to it. If the set is compressed, the block elt would be in is found the same way searchBlocks finds it and is decoded up to elt. Neither changes the layout of the set. Assert is used to make sure none of the pointers used are null.
+ *Big-O notation: O(log(n))
+ */
+int rankElement(SET *sp, char *elt)
+{
+	assert(sp != NULL);
+	assert(elt != NULL);
+	bool found;
+	int i, rank;
+	if(sp->frozen)
+	{
+		int index = search(sp, elt, &found);
+		rank = sp->ranks[index / BLOCK_KEYS];
+		for(i = index / BLOCK_KEYS * BLOCK_KEYS; i < index; i++)
+		{
+			rank += !sp->removed[i];
+		}
+		return rank;
+	}
+	if(sp->compressed)
+	{
+		int block = findBlock(sp, elt);
+		if(block == -1)
+		{
+			return 0;
+		}
+		char *p = sp->blob + sp->heads[block];
+		int end = block*BLOCK_KEYS + BLOCK_KEYS < sp->size ? block*BLOCK_KEYS + BLOCK_KEYS : sp->size;
+		int length = strlen(p);
+		memcpy(sp->scratch, p, length + 1);
+		p += length + 1;
+		rank = sp->ranks[block];
+		//every string of the block before the first one not less than elt is counted, unless it was removed
+		for(i = block*BLOCK_KEYS; i < end && strcmp(sp->scratch, elt) < 0; i++)
+		{
+			rank += !sp->removed[i];
+			if(i + 1 < end)
+			{
+				p = decodeNext(sp, p);
+			}
+		}
+		return rank;
+	}
+	return search(sp, elt, &found);
+}
+
+/*Returns the string of rank k in set sp, meaning the one with k strings less than it, which is just data[k] if the set is sorted. If the set is frozen or compressed, the block holding it is found by binary search over ranks, and then the block is scanned, skipping removed strings, until the string is reached, either in data or by decoding the block. Neither changes the layout of the set. The string is the one held by the set rather than a copy, except for a compressed set, where it is decoded into scratch and is only valid until the next call. Assert is used to make sure k is in range.
+ *Big-O notation: O(1), or O(log(n)) if the set is frozen or compressed
+ */
+char *selectElement(SET *sp, int k)
+{
+	assert(sp != NULL);
+	assert(k >= 0 && k < sp->count);
+	if(!sp->frozen && !sp->compressed)
+	{
+		return sp->data[k];
+	}
+
+	int block = findRankBlock(sp, k);
+	int i = block*BLOCK_KEYS;
+	int left = k - sp->ranks[block];
+	if(sp->frozen)
+	{
+		//skips strings until the one with left strings that haven't been removed before it in the block
+		while(sp->removed[i] || left-- > 0)
+		{
+			i++;
+		}
+		return sp->data[i];
+	}
+
+	char *p = sp->blob + sp->heads[block];
+	int length = strlen(p);
+	memcpy(sp->scratch, p, length + 1);
+	p += length + 1;
+	while(sp->removed[i] || left-- > 0)
+	{
+		p = decodeNext(sp, p);
+		i++;
+	}
+	return sp->scratch;
+}
+
+/*Returns the number of strings in set sp that are not less than lo and less than hi, and stores the rank of the first of them in first, so they can be walked with selectElement without copying them. Either bound may be null to leave that end of the range open. Both ends are found with rankElement, so the layout of the set isn't changed.
+ *Big-O notation: O(log(n))
+ */
+int findRange(SET *sp, char *lo, char *hi, int *first)
+{
+	assert(sp != NULL);
+	assert(first != NULL);
+	int low = lo != NULL ? rankElement(sp, lo) : 0;
+	int high = hi != NULL ? rankElement(sp, hi) : sp->count;
+	*first = low;
+	return high > low ? high - low : 0;
+}
+
+/*Returns the number of strings in set sp that start with prefix, and stores the rank of the first of them in first. Since the set is sorted, these strings are all next to each other starting at the rank of prefix, so a binary search over ranks using selectElement finds where they end. The layout of the set isn't changed.
+ *Big-O notation: O(log(n)), or O(log(n)^2) if the set is frozen or compressed
+ */
+int findPrefix(SET *sp, char *prefix, int *first)
+{
+	assert(sp != NULL);
+	assert(prefix != NULL);
+	assert(first != NULL);
+	int length = strlen(prefix);
+	int low = rankElement(sp, prefix);
+	int high = sp->count;
+	*first = low;
+
+	//binary search for the first string after low that doesn't start with prefix, all of which are greater than it
+	while(low < high)
+	{
+		int mid = (low+high)/2;
+		if(strncmp(selectElement(sp, mid), prefix, length) == 0)
+		{
+			low = mid + 1;
+		}
+		else
+		{
+			high = mid;
+		}
+	}
+	return low - *first;
+}
+
+/*Fills the Eytzinger array tree of set sp from the sorted array data by an in-order walk of the implicit tree, where the children of index k are 2k and 2k+1. next is the index in data of the next string to place.
+ *Big-O notation: O(n)
+ */
+static void fillTree(SET *sp, int k, int *next)
+{
+	if(k > sp->size)
+	{
+		return;
+	}
+	fillTree(sp, 2*k, next);
+	sp->tree[k] = sp->data[(*next)++];
+	fillTree(sp, 2*k+1, next);
+}
+
+/*Returns the index in sorted order of the string at index k of the Eytzinger array tree of frozen set sp, without walking the tree. If the bottom level of the tree were full, the strings in sorted order would be an in-order walk of a perfect tree, where the index of k follows from its depth and its place within that level. The leaves missing from the right end of the bottom level would each have been at every other index from missing on, so the ones before k are taken away.
+ *Big-O notation: O(1)
+ */
+static int treePosition(SET *sp, int k)
+{
+	int height = 31 - __builtin_clz(sp->size);
+	int depth = 31 - __builtin_clz(k);
+	int index = ((2*(k - (1 << depth)) + 1) << (height - depth)) - 1;
+	int missing = 2*(sp->size + 1 - (1 << height));
+	return index > missing ? index - (index - missing + 1)/2 : index;
+}
+
+/*Sets up ranks for frozen or compressed set sp, when none of its strings have been removed yet, so every block before block b holds BLOCK_KEYS strings.
+ *Big-O notation: O(n/BLOCK_KEYS)
+ */
+static void fillRanks(SET *sp)
+{
+	sp->blocks = (sp->size + BLOCK_KEYS - 1) / BLOCK_KEYS;
+	sp->ranks = malloc(sizeof(int)*(sp->blocks + 1));
+	assert(sp->ranks != NULL);
+	int b;
+	for(b = 0; b <= sp->blocks; b++)
+	{
+		sp->ranks[b] = b*BLOCK_KEYS < sp->size ? b*BLOCK_KEYS : sp->size;
+	}
+}
+
+/*Marks the string at index i in sorted order of frozen or compressed set sp as removed, unless it already is, and takes it out of ranks for every block after its own.
+ *Big-O notation: O(n/BLOCK_KEYS)
+ */
+static void removeAt(SET *sp, int i)
+{
+	if(sp->removed[i])
+	{
+		return;
+	}
+	sp->removed[i] = true;
+	sp->count--;
+	int b;
+	for(b = i / BLOCK_KEYS + 1; b <= sp->blocks; b++)
+	{
+		sp->ranks[b]--;
+	}
+}
+
+/*Freezes set sp for lookups by rearranging its strings into Eytzinger (breadth-first) order, with the root of the implicit binary search tree at index 1 and the children of index k at 2k and 2k+1. The first several levels of the tree are then packed together at the front of the array, so a search touches far fewer cache lines than a binary search over the sorted array. The set can still be changed while frozen: removals only mark strings, and an addition thaws the set back into data first. data and keys are kept as they are, so rankElement and selectElement can still use the sorted order. Freezing a frozen set does nothing, and neither does freezing a compressed set, which is searched by its own blocks.
+ *Big-O notation: O(n)
+ */
+void freezeSet(SET *sp)
+{
+	assert(sp != NULL);
+	if(sp->frozen || sp->compressed)
+	{
+		return;
+	}
+
+	sp->size = sp->count;
+	sp->tree = malloc(sizeof(char*)*(sp->size+1));
+	sp->removed = calloc(sp->size+1, sizeof(bool));
+	assert(sp->tree != NULL && sp->removed != NULL);
+
+	int next = 0;
+	fillTree(sp, 1, &next);
+	fillRanks(sp);
+	sp->frozen = true;
+}
+
+/*Thaws set sp if it is frozen or compressed, putting the strings that have not been removed back into data in sorted order and dropping the rest, and then rebuilds keys to match. A frozen set still has its strings in order in data, so the ones that have not been removed only need to be slid down over the ones that have.
+ *Big-O notation: O(n)
+ */
+static void thawSet(SET *sp)
+{
+	if(sp->compressed)
+	{
+		expandBlocks(sp);
+	}
+	else if(sp->frozen)
+	{
+		int i, next = 0;
+		for(i = 0; i < sp->size; i++)
+		{
+			if(!sp->removed[i])
+			{
+				sp->data[next++] = sp->data[i];
+			}
+		}
+		assert(next == sp->count);
+		free(sp->tree);
+		free(sp->removed);
+		sp->tree = NULL;
+		sp->removed = NULL;
+		sp->frozen = false;
+	}
+	else
+	{
+		return;
+	}
+	free(sp->ranks);
+	sp->ranks = NULL;
+	fillKeys(sp);
+}
+
+/*Returns the length of the prefix shared by strings a and b, up to UCHAR_MAX so that it fits in the one byte it is stored in.
+ *Big-O notation: O(n) where n is the length of the prefix
+ */
+static int sharedPrefix(char *a, char *b)
+{
+	int i = 0;
+	while(i < UCHAR_MAX && a[i] != '\0' && a[i] == b[i])
+	{
+		i++;
+	}
+	return i;
+}
+
+/*Compresses set sp by front coding its strings. Adjacent strings in sorted order tend to share long prefixes, so the strings are packed into one array blob in blocks of BLOCK_KEYS: the first string of each block is stored in full, and each of the rest as one byte giving the length of the prefix it shares with the string before it, followed by the rest of the string. The separate copies of the strings and the arrays data and keys are then freed. A search is a binary search over the first strings of the blocks followed by decoding at most one block, so it is still O(log(n)). The set can still be changed while compressed: removals only mark strings, and an addition thaws the set back into data first. Compressing a compressed set does nothing.
+ *Big-O notation: O(n)
+ */
+void compressSet(SET *sp)
+{
+	assert(sp != NULL);
+	if(sp->compressed)
+	{
+		return;
+	}
+	thawSet(sp);
+
+	int i, length, shared, total = 0, longest = 0;
+	//finds how many bytes the front-coded strings take and how long the longest string is
+	for(i = 0; i < sp->count; i++)
+	{
+		length = strlen(sp->data[i]);
+		longest = length > longest ? length : longest;
+		if(i % BLOCK_KEYS == 0)
+		{
+			total += length + 1;
+		}
+		else
+		{
+			total += 1 + length - sharedPrefix(sp->data[i-1], sp->data[i]) + 1;
+		}
+	}
+
+	sp->size = sp->count;
+	fillRanks(sp);
+	sp->blob = malloc(total);
+	sp->heads = malloc(sizeof(int)*sp->blocks);
+	sp->scratch = malloc(longest + 1);
+	sp->removed = calloc(sp->size + 1, sizeof(bool));
+	assert((sp->blob != NULL && sp->heads != NULL && sp->removed != NULL) || sp->size == 0);
+	assert(sp->scratch != NULL);
+
+	char *p = sp->blob;
+	for(i = 0; i < sp->count; i++)
+	{
+		length = strlen(sp->data[i]);
+		if(i % BLOCK_KEYS == 0)
+		{
+			sp->heads[i / BLOCK_KEYS] = p - sp->blob;
+			memcpy(p, sp->data[i], length + 1);
+			p += length + 1;
+		}
+		else
+		{
+			shared = sharedPrefix(sp->data[i-1], sp->data[i]);
+			*p++ = shared;
+			memcpy(p, sp->data[i] + shared, length - shared + 1);
+			p += length - shared + 1;
+		}
+	}
+
+	//the strings can only be freed once they have all been compared with their neighbors, and are all freed at once by starting a new arena
+	destroyArena(sp->arena);
+	sp->arena = createArena(true);
+	free(sp->data);
+	free(sp->keys);
+	sp->data = NULL;
+	sp->keys = NULL;
+	sp->compressed = true;
+}
+
+/*Decodes the string after the one in the scratch buffer of set sp, which starts at p in blob, into the scratch buffer. Returns the position in blob of the string after it.
+ *Big-O notation: O(n) where n is the length of the string
+ */
+static char *decodeNext(SET *sp, char *p)
+{
+	int shared = (unsigned char)*p++;
+	int length = strlen(p);
+	memcpy(sp->scratch + shared, p, length + 1);
+	return p + length + 1;
+}
+
+/*Returns the last block of compressed set sp whose first string is not greater than elt, or -1 if elt comes before every block. Uses binary search over the first strings of the blocks.
+ *Big-O notation: O(log(n))
+ */
+static int findBlock(SET *sp, char *elt)
+{
+	int low = 0;
+	int high = sp->blocks - 1;
+	int mid, block = -1;
+	while(low <= high)
+	{
+		mid = (low+high)/2;
+		if(strcmp(sp->blob + sp->heads[mid], elt) <= 0)
+		{
+			block = mid;
+			low = mid + 1;
+		}
+		else
+		{
+			high = mid - 1;
+		}
+	}
+	return block;
+}
+
+/*Searches compressed set sp for elt, and returns its index among the strings held, or -1 if it is not there. Uses findBlock to find the last block that starts at or before elt, and then decodes that block into scratch one string at a time until elt is reached or passed. If elt is found, it is left in scratch.
+ *Big-O notation: O(log(n))
+ */
+static int searchBlocks(SET *sp, char *elt)
+{
+	int block = findBlock(sp, elt);
+	if(block == -1)
+	{
+		return -1;
+	}
+
+	char *p = sp->blob + sp->heads[block];
+	int i = block * BLOCK_KEYS;
+	int end = i + BLOCK_KEYS < sp->size ? i + BLOCK_KEYS : sp->size;
+	int length = strlen(p);
+	memcpy(sp->scratch, p, length + 1);
+	p += length + 1;
+
+	//the strings in a block are in order, so the search can stop at the first one not less than elt
+	while(true)
+	{
+		int result = strcmp(sp->scratch, elt);
+		if(result == 0)
+		{
+			return i;
+		}
+		if(result > 0 || ++i == end)
+		{
+			return -1;
+		}
+		p = decodeNext(sp, p);
+	}
+}
+
+/*Thaws compressed set sp by decoding every string in blob into a copy in the arena and a new array data, skipping the ones marked as removed, and then freeing the blocks.
+ *Big-O notation: O(n)
+ */
+static void expandBlocks(SET *sp)
+{
+	sp->data = malloc(sizeof(char*)*sp->length);
+	sp->keys = malloc(sizeof(uint64_t)*sp->length);
+	assert(sp->data != NULL && sp->keys != NULL);
+
+	int i, length, next = 0;
+	char *p = sp->blob;
+	for(i = 0; i < sp->size; i++)
+	{
+		if(i % BLOCK_KEYS == 0)
+		{
+			length = strlen(p);
+			memcpy(sp->scratch, p, length + 1);
+			p += length + 1;
+		}
+		else
+		{
+			p = decodeNext(sp, p);
+		}
+		if(!sp->removed[i])
+		{
+			length = strlen(sp->scratch);
+			sp->data[next++] = copyArena(sp->arena, sp->scratch, length);
+		}
+	}
+	assert(next == sp->count);
+
+	free(sp->blob);
+	free(sp->heads);
+	free(sp->scratch);
+	free(sp->removed);
+	sp->blob = NULL;
+	sp->heads = NULL;
+	sp->scratch = NULL;
+	sp->removed = NULL;
+	sp->compressed = false;
+}
+
+/*Searches the Eytzinger array tree of frozen set sp for elt, and returns its index in tree, or -1 if it is not there. Each step goes to child 2k or 2k+1 depending on a comparison, without a branch, and prefetches the slots four levels further down, which are 16 consecutive pointers. At the end, k has gone past the bottom of the tree, and shifting off the right turns taken since the last left turn gives the smallest string not less than elt.
+ *Big-O notation: O(log(n))
+ */
+static int searchTree(SET *sp, char *elt)
+{
+	int k = 1;
+	while(k <= sp->size)
+	{
+		__builtin_prefetch(sp->tree + 16*k);
+		k = 2*k + (strcmp(sp->tree[k], elt) < 0);
+	}
+	k >>= __builtin_ffs(~k);
+	return (k != 0 && strcmp(sp->tree[k], elt) == 0) ? k : -1;
+}
+
+/*Packs the first 8 bytes of string elt into an integer, with the first byte as the most significant, padding with zeros if elt is shorter. Since the bytes are compared as unsigned like strcmp does, and the terminator is smaller than any character, comparing the keys of two strings gives the same order as strcmp whenever the keys differ.
+ *Big-O notation: O(1)
+ */
+static uint64_t makeKey(char *elt)
+{
+	uint64_t key = 0;
+	int i;
+	for(i = 0; i < 8 && elt[i] != '\0'; i++)
+	{
+		key |= (uint64_t)(unsigned char)elt[i] << (56 - 8*i);
+	}
+	return key;
+}
+
+/*Sets keys[i] to the key of data[i] for every string in set sp, allocating keys first if it was freed by compressSet.
+ *Big-O notation: O(n)
+ */
+static void fillKeys(SET *sp)
+{
+	if(sp->keys == NULL)
+	{
+		sp->keys = malloc(sizeof(uint64_t)*sp->length);
+		assert(sp->keys != NULL);
+	}
+	int i;
+	for(i = 0; i < sp->count; i++)
+	{
+		sp->keys[i] = makeKey(sp->data[i]);
+	}
+}
+
+/*Searches the array data in the set sp for a given element elt. Returns the index elt is located at, or the index where it should be located in the array based off of its alphabetical ordering. Uses a boolean value passed in by reference to indicate whether the returned value is the index of the element, or the index of where the element should be located. Uses binary search since array is sorted. Each step compares the key of elt with keys[mid], which sits in one contiguous array, and only looks at the string data[mid] when the two keys are the same. Even then, if elt is shorter than 8 bytes the strings must be equal, and otherwise only the bytes after the first 8 are compared.
  *Big-O: O(log(n))
  */
 static int search (SET *sp, char *elt, bool *found)
@@ -150,19 +947,31 @@ static int search (SET *sp, char *elt, bool *found)
 	assert(elt != NULL);
 	assert(found != NULL);
 	int low = 0;
-	int high = sp->count-1;
-	int mid = 0;	
+	//a frozen set also keeps the strings removed since it was frozen in data
+	int high = (sp->frozen ? sp->size : sp->count) - 1;
+	int mid = 0;
+	int result;
+	uint64_t key = makeKey(elt);
 	
 	//loop used to conduct binary search
 	while(low <= high)
 	{
 		mid = (high+low)/2;
-		if(strcmp(sp->data[mid],elt) == 0)
+		if(sp->keys[mid] != key)
+		{
+			result = sp->keys[mid] < key ? -1 : 1;
+		}
+		else
+		{
+			result = (key & 0xff) == 0 ? 0 : strcmp(sp->data[mid] + 8, elt + 8);
+		}
+
+		if(result == 0)
 		{
 			*found = true;
 			return mid;
 		}
-		else if(strcmp(sp->data[mid],elt) <  0)
+		else if(result < 0)
 		{
 			low = mid + 1;			
 		}
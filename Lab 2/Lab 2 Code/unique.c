@@ -11,19 +11,62 @@
  *              are inserted into the set and the counts of total words and
  *              total words in the set are printed.  If the second file is
  *              given then all words in the second file are deleted from
- *              the set and the count printed.
+ *              the set and the count printed.  With -f, words are
+ *              lowercased and stripped of surrounding punctuation first.
+ *              With -c, the set is compressed once the first file is in.
+ *              With -d, the words in the second file are made into a set
+ *              of their own and subtracted from the first set all at once.
  */
 
 # include <stdio.h>
 # include <stdlib.h>
 # include <string.h>
 # include <stdbool.h>
+# include <assert.h>
 # include "set.h"
+# include "token.h"
+# include "arena.h"
 
 
-/* This is sufficient for the test cases in /scratch/coen12. */
+/* This is sufficient for the test cases in /scratch/coen12.  Larger inputs
+   can be run by compiling with -DMAX_SIZE=n. */
 
+# ifndef MAX_SIZE
 # define MAX_SIZE 18000
+# endif
+
+
+/*
+ * Function:    readWords
+ *
+ * Description: Return an array of all words read by the tokenizer TP,
+ *		copied into the arena pointed to by AP, storing the number of
+ *		words in *COUNT.
+ */
+
+static char **readWords(TOKENIZER *tp, ARENA *ap, int *count)
+{
+    char *word, **elts;
+    int length, size;
+
+
+    *count = 0;
+    size = 1024;
+    elts = malloc(sizeof(char *) * size);
+    assert(elts != NULL);
+
+    while ((word = nextToken(tp, &length)) != NULL) {
+	if (*count == size) {
+	    size *= 2;
+	    elts = realloc(elts, sizeof(char *) * size);
+	    assert(elts != NULL);
+	}
+
+	elts[(*count) ++] = copyArena(ap, word, length);
+    }
+
+    return elts;
+}
 
 
 /*
@@ -34,17 +77,27 @@
 
 int main(int argc, char *argv[])
 {
-    FILE *fp;
-    char buffer[BUFSIZ], **elts;
-    SET *unique;
-    int i, words;
-    bool lflag = false;
+    TOKENIZER *tp;
+    char *word, **elts;
+    SET *unique, *other;
+    ARENA *ap;
+    int i, words, length;
+    bool lflag = false, fflag = false, cflag = false, dflag = false;
 
 
     /* Check usage and open the first file. */
 
-    if (argc > 1 && strcmp(argv[1], "-l") == 0) {
-	lflag = true;
+    while (argc > 1 && (strcmp(argv[1], "-l") == 0 || strcmp(argv[1], "-f") == 0 ||
+	    strcmp(argv[1], "-c") == 0 || strcmp(argv[1], "-d") == 0)) {
+	if (strcmp(argv[1], "-l") == 0)
+	    lflag = true;
+	else if (strcmp(argv[1], "-f") == 0)
+	    fflag = true;
+	else if (strcmp(argv[1], "-c") == 0)
+	    cflag = true;
+	else
+	    dflag = true;
+
 	argc --;
 
 	for (i = 1; i < argc; i ++)
@@ -52,27 +105,33 @@ int main(int argc, char *argv[])
     }
 
     if (argc == 1 || argc > 3) {
-        fprintf(stderr, "usage: %s [-l] file1 [file2]\n", argv[0]);
+        fprintf(stderr, "usage: %s [-l] [-f] [-c] [-d] file1 [file2]\n", argv[0]);
         exit(EXIT_FAILURE);
     }
 
-    if ((fp = fopen(argv[1], "r")) == NULL) {
+    if ((tp = openTokenizer(argv[1])) == NULL) {
         fprintf(stderr, "%s: cannot open %s\n", argv[0], argv[1]);
         exit(EXIT_FAILURE);
     }
 
+    foldTokens(tp, fflag);
 
-    /* Insert all words into the set. */
 
-    words = 0;
-    unique = createSet(MAX_SIZE);
+    /* Collect all words and build the set from them at once.  The set
+       makes its own copies, so the words are kept in an arena that
+       interns them, which stores each distinct word only once, and is
+       then thrown away in one piece. */
 
-    while (fscanf(fp, "%s", buffer) == 1) {
-        words ++;
-        addElement(unique, buffer);
-    }
+    ap = createArena(true);
+    elts = readWords(tp, ap, &words);
+    closeTokenizer(tp);
 
-    fclose(fp);
+    unique = createSetFrom(MAX_SIZE, elts, words);
+    destroyArena(ap);
+    free(elts);
+
+    if (cflag)
+	compressSet(unique);
 
     if (!lflag) {
 	printf("%d total words\n", words);
@@ -83,18 +142,36 @@ int main(int argc, char *argv[])
     /* Try to open the second file. */
 
     if (argc == 3) {
-        if ((fp = fopen(argv[2], "r")) == NULL) {
+        if ((tp = openTokenizer(argv[2])) == NULL) {
             fprintf(stderr, "%s: cannot open %s\n", argv[0], argv[2]);
             exit(EXIT_FAILURE);
         }
 
+	foldTokens(tp, fflag);
+
+
+        /* Delete all words in the second file, either as a set of
+           their own or one at a time, which are mostly lookups of words
+           that are not in the set. */
+
+	if (dflag) {
+	    ap = createArena(true);
+	    elts = readWords(tp, ap, &words);
+	    other = createSetFrom(MAX_SIZE, elts, words);
+	    destroyArena(ap);
+	    free(elts);
+
+	    differenceSet(unique, other);
+	    destroySet(other);
 
-        /* Delete all words in the second file. */
+	} else {
+	    freezeSet(unique);
 
-        while (fscanf(fp, "%s", buffer) == 1)
-            removeElement(unique, buffer);
+	    while ((word = nextToken(tp, &length)) != NULL)
+		removeElementLen(unique, word, length);
+	}
 
-	fclose(fp);
+	closeTokenizer(tp);
 
 	if (!lflag)
 	    printf("%d remaining words\n", numElements(unique));
@@ -6,44 +6,152 @@
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <stdint.h>
+#include <stdbool.h>
 #include "set.h"
+#include "arena.h"
 
-static int search(SET *sp, char *elt);
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define HAVE_X86
+#endif
 
-//definition of the structure set
+//number of fingerprints compared at once by matchPrints, and by matchPrintsAVX2 if the processor has AVX2
+#ifdef __SSE2__
+#define PRINT_WIDTH 16
+#else
+#define PRINT_WIDTH 8
+#endif
+#define WIDE_PRINT_WIDTH 32
+
+static int search(SET *sp, char *elt, int length);
+static int scanPrints(SET *sp, char *elt, int length, unsigned char print);
+static void chooseScan(void);
+
+//definition of the structure set. The strings themselves are all copied into arena, which interns them so that a string that is removed and added again reuses its old copy, and which frees them all at once when the set is destroyed. prints[i] and lengths[i] hold a one-byte hash and the length of data[i], so that a search can skip most strings without looking at them. prints has WIDE_PRINT_WIDTH bytes of padding at the end so that it can always be read a whole chunk at a time, whichever scan is used. order is a sorted copy of data made by selectElement, which is null until the first call and is dropped whenever a string is added or removed.
 typedef struct set
 {
 	char **data;
+	unsigned char *prints;
+	int *lengths;
+	ARENA *arena;
 	int length;
 	int count;
+	char **order;
 }SET;
 
-/*Creates the set, taking in an argument maxElts that represents the maximum number of words that can be stored in the array data. The set and array data are both allocated the appropriate amount of memory, length is set to maxElts, and count is set to 0. Assert is used to make sure that none of the pointers used are null. 
+/*Creates the set, taking in an argument maxElts that represents the maximum number of words that can be stored in the array data. The set and array data are both allocated the appropriate amount of memory, length is set to maxElts, and count is set to 0. The fingerprint scan used by search is chosen here for the processor the first time a set is created. Assert is used to make sure that none of the pointers used are null. 
 Big-O notation: O(1) */ 
 SET *createSet(int maxElts)
 {
+	chooseScan();
 	SET *setptr = malloc(sizeof(SET));
 	assert(setptr != NULL);
 	setptr->length = maxElts;
 	setptr->data = malloc(sizeof(char*)*maxElts);
-	assert(setptr->data != NULL);
+	setptr->prints = calloc(maxElts + WIDE_PRINT_WIDTH, 1);
+	setptr->lengths = malloc(sizeof(int)*maxElts);
+	assert(setptr->data != NULL && setptr->prints != NULL && setptr->lengths != NULL);
+	setptr->arena = createArena(true);
 	setptr->count = 0;
+	setptr->order = NULL;
 	return setptr;
 
 }
 
-/*Deallocates the memory given to inputted set sp, first freeing every memory location in data and then freeing the memory of the set sp itself. Assert is used to make sure none of the pointers used are null.
- * Big-O notation: O(n)
+/*Returns a one-byte hash of string elt, whose length is already known. It is the top byte of the 32-bit FNV-1a hash of elt, since the high bits of FNV-1a are better mixed than the low ones.
+ *Big-O notation: O(n) where n is the length of elt
  */
-void destroySet(SET *sp)
+static unsigned char fingerprint(char *elt, int length)
 {
-	assert(sp != NULL);
+	uint32_t hash = 2166136261u;
 	int i;
-	//Frees memory allocated to each element of the array. Memory allocated to the set sp is freed afterwards since sp is needed to free the elements in data.  
-	for(i = 0; i < sp->count; i++)
+	for(i = 0; i < length; i++)
+	{
+		hash = (hash ^ (unsigned char)elt[i]) * 16777619u;
+	}
+	return hash >> 24;
+}
+
+/*Stores string elt, whose length is already known, at index i of data along with its fingerprint and length.
+ *Big-O notation: O(n) where n is the length of elt
+ */
+static void putSlot(SET *sp, int i, char *elt, int length)
+{
+	sp->data[i] = elt;
+	sp->prints[i] = fingerprint(elt, length);
+	sp->lengths[i] = length;
+}
+
+/*Compares the two array slots pointed to by p and q, for sorting an array of pointers into elts with qsort. Slots holding equal strings are ordered by their position in elts, so the first copy of each string comes first.
+ *Big-O notation: O(1)
+ */
+static int compareSlots(const void *p, const void *q)
+{
+	char **a = *(char ***)p;
+	char **b = *(char ***)q;
+	int result = strcmp(*a, *b);
+	if(result != 0)
+	{
+		return result;
+	}
+	return (a > b) - (a < b);
+}
+
+/*Creates a set holding the n strings in elts, taking in maxElts the same way as createSet. Rather than searching data for each string as addElement does, pointers to the strings are sorted once so that copies of the same string end up next to each other, and every copy after the first is marked as a duplicate. Copies of the remaining strings are then put into data in the order they appear in elts, which is the same order addElement would have given them. The strings in elts and the array elts itself still belong to the caller. Assert is used to make sure none of the pointers used are null and that the strings fit.
+ *Big-O notation: O(n log(n))
+ */
+SET *createSetFrom(int maxElts, char **elts, int n)
+{
+	assert(elts != NULL || n == 0);
+	SET *setptr = createSet(maxElts);
+	char ***slots = malloc(sizeof(char**)*n);
+	bool *duplicate = calloc(n + 1, sizeof(bool));
+	assert((slots != NULL || n == 0) && duplicate != NULL);
+
+	int i;
+	for(i = 0; i < n; i++)
+	{
+		slots[i] = &elts[i];
+	}
+	qsort(slots, n, sizeof(char**), compareSlots);
+
+	//marks every copy of a string after its first one as a duplicate
+	for(i = 1; i < n; i++)
+	{
+		if(strcmp(*slots[i], *slots[i-1]) == 0)
+		{
+			duplicate[slots[i] - elts] = true;
+		}
+	}
+	free(slots);
+
+	//copies the strings that are left into data in their original order
+	for(i = 0; i < n; i++)
 	{
-		free(sp->data[i]);
-	} 
+		if(!duplicate[i])
+		{
+			assert(setptr->count < setptr->length);
+			int length = strlen(elts[i]);
+			putSlot(setptr, setptr->count++, copyArena(setptr->arena, elts[i], length), length);
+		}
+	}
+	free(duplicate);
+	return setptr;
+}
+
+/*Deallocates the memory given to inputted set sp, first freeing every string at once by destroying the arena, then the arrays, and then the memory of the set sp itself. Assert is used to make sure none of the pointers used are null.
+ * Big-O notation: O(1)
+ */
+void destroySet(SET *sp)
+{
+	assert(sp != NULL);
+	//Frees every string at once by destroying the arena, and then the arrays. Memory allocated to the set sp is freed afterwards since sp is needed to find them.  
+	destroyArena(sp->arena);
+	free(sp->data);
+	free(sp->prints);
+	free(sp->lengths);
+	free(sp->order);
 	free(sp);
 }
 
@@ -56,10 +164,19 @@ int numElements(SET *sp)
 	return sp->count;
 }
 
-/*Adds an inputted string elt into the array data of set sp. Will prevent elt from being added to the array if the array data is already holding its maximum number of elements, or if the value of elt is already present in the array. Assert is used to make sure none of the pointers used are null.
+/*Adds an inputted string elt into the array data of set sp. Will prevent elt from being added to the array if the array data is already holding its maximum number of elements, or if the value of elt is already present in the array. Measures elt and passes it to addElementLen. Assert is used to make sure none of the pointers used are null.
  *Big-O notation: O(n)
  */
 void addElement(SET *sp, char *elt)
+{
+	assert(elt != NULL);
+	addElementLen(sp, elt, strlen(elt));
+}
+
+/*Same as addElement, but takes the length of elt from the caller so that the copy in the arena can be made without measuring elt again. Drops the sorted copy made by selectElement, since it no longer matches. Assert is used to make sure none of the pointers used are null.
+ *Big-O notation: O(n)
+ */
+void addElementLen(SET *sp, char *elt, int length)
 {
 	assert(sp != NULL);
 	assert(elt != NULL);
@@ -67,46 +184,68 @@ void addElement(SET *sp, char *elt)
 	assert(sp->count <= sp->length);
 	
 	//checks to see if elt is already in the set
-	if(search(sp, elt) != -1)
+	if(search(sp, elt, length) != -1)
 	{
 		return;	
 	}
 	
-	//Adds elt to the array data by using strdup. Elt is always added to the end of the array since order doesn't matter. 
-	sp->data[sp->count] = strdup(elt);
-	assert(sp->data[sp->count] != NULL);
+	//Adds a copy of elt to the array data. Elt is always added to the end of the array since order doesn't matter. 
+	putSlot(sp, sp->count, copyArena(sp->arena, elt, length), length);
 	sp->count++;
+	free(sp->order);
+	sp->order = NULL;
 }
 
-/*Removes inputted string elt from the set sp. Makes sure that elt exists in the set first before removing. Assert is used to make sure none of the pointers used are null.  
+/*Removes inputted string elt from the set sp. Measures elt and passes it to removeElementLen. Assert is used to make sure none of the pointers used are null.  
  *Big-O notation: O(n)
  */
 void removeElement(SET *sp, char *elt)
+{
+	assert(elt != NULL);
+	removeElementLen(sp, elt, strlen(elt));
+}
+
+/*Same as removeElement, but takes the length of elt from the caller so that it doesn't have to be measured again before searching. Makes sure that elt exists in the set first before removing, and drops the sorted copy made by selectElement if it does. Assert is used to make sure none of the pointers used are null.
+ *Big-O notation: O(n)
+ */
+void removeElementLen(SET *sp, char *elt, int length)
 {
 	assert(sp != NULL);
 	assert(elt != NULL);
 	//searches set to see if elt is located within the array data
-	int elementIndex = search(sp, elt);
+	int elementIndex = search(sp, elt, length);
 	//checks to see if elt is in the set, ending the funciton early if it is not in the set
 	if(elementIndex == -1)
 	{
 		return;
 	}
 	
-	//Sets the location currently storing elt equal to the final value in the array. Done this way since order doesn't matter in the array. 
-	free(sp->data[elementIndex]);
+	//Sets the location currently storing elt equal to the final value in the array. Done this way since order doesn't matter in the array. The string itself stays in the arena until the set is destroyed.
 	sp->data[elementIndex] = sp->data[sp->count-1];
+	sp->prints[elementIndex] = sp->prints[sp->count-1];
+	sp->lengths[elementIndex] = sp->lengths[sp->count-1];
 	sp->count--; 
+	free(sp->order);
+	sp->order = NULL;
 }
 
-/*Finds inputted string elt in set sp. Uses search function to find the matching string, and then returns that string. Returns null if string isn't found. Assert is used to make sure no pointers passed in to the method are null. 
+/*Finds inputted string elt in set sp. Measures elt and passes it to findElementLen. Assert is used to make sure no pointers passed in to the method are null. 
  *Big-O notation: O(n)
  */
 char *findElement(SET *sp, char *elt)
+{
+	assert(elt != NULL);
+	return findElementLen(sp, elt, strlen(elt));
+}
+
+/*Same as findElement, but takes the length of elt from the caller so that it doesn't have to be measured again. Uses search function to find the matching string, and then returns that string. Returns null if string isn't found.
+ *Big-O notation: O(n)
+ */
+char *findElementLen(SET *sp, char *elt, int length)
 {
 	assert(sp != NULL);
 	assert(elt != NULL);
-	int elementIndex = search(sp, elt);
+	int elementIndex = search(sp, elt, length);
 	//checks if string exists in the set, and returns null if string isn't found in the set
 	if(elementIndex != -1)
 	{
@@ -115,6 +254,155 @@ char *findElement(SET *sp, char *elt)
 	return NULL; 		
 }
 
+/*Adds a copy of every string in set other to set sp, one at a time with addElement, which is the best that can be done without an order to merge by.
+ *Big-O notation: O(nm)
+ */
+void unionSet(SET *sp, SET *other)
+{
+	assert(sp != NULL && other != NULL);
+	int i;
+	for(i = 0; i < other->count; i++)
+	{
+		addElement(sp, other->data[i]);
+	}
+}
+
+/*Removes every string in set other from set sp, one at a time with removeElement.
+ *Big-O notation: O(nm)
+ */
+void differenceSet(SET *sp, SET *other)
+{
+	assert(sp != NULL && other != NULL);
+	int i;
+	for(i = 0; i < other->count; i++)
+	{
+		removeElement(sp, other->data[i]);
+	}
+}
+
+/*Removes every string that is not also in set other from set sp. Goes through data from the end so that removing a string, which moves the last string into its place, never skips one that has not been checked yet.
+ *Big-O notation: O(nm)
+ */
+void intersectSet(SET *sp, SET *other)
+{
+	assert(sp != NULL && other != NULL);
+	int i;
+	for(i = sp->count-1; i >= 0; i--)
+	{
+		if(findElement(other, sp->data[i]) == NULL)
+		{
+			removeElement(sp, sp->data[i]);
+		}
+	}
+}
+
+/*Returns the number of strings in set sp that are less than elt, counting them with one pass over data since it isn't sorted.
+ *Big-O notation: O(n)
+ */
+int rankElement(SET *sp, char *elt)
+{
+	assert(sp != NULL);
+	assert(elt != NULL);
+	int i, rank = 0;
+	for(i = 0; i < sp->count; i++)
+	{
+		if(strcmp(sp->data[i], elt) < 0)
+		{
+			rank++;
+		}
+	}
+	return rank;
+}
+
+/*Compares the two strings pointed to by p and q, for sorting an array of strings with qsort.
+ *Big-O notation: O(1)
+ */
+static int compareStrings(const void *p, const void *q)
+{
+	return strcmp(*(char **)p, *(char **)q);
+}
+
+/*Returns the string of rank k in set sp, meaning the one with k strings less than it. The first call after the set changes copies the pointers in data into order and sorts them, which takes O(n log(n)), and every later call until the next change just returns order[k]. This way data itself is never reordered, and walking the strings of a range with selectElement sorts them only once. Assert is used to make sure k is in range.
+ *Big-O notation: O(n log(n)) for the first call after a change, O(1) after that
+ */
+char *selectElement(SET *sp, int k)
+{
+	assert(sp != NULL);
+	assert(k >= 0 && k < sp->count);
+	if(sp->order == NULL)
+	{
+		sp->order = malloc(sizeof(char*)*sp->count);
+		assert(sp->order != NULL);
+		memcpy(sp->order, sp->data, sizeof(char*)*sp->count);
+		qsort(sp->order, sp->count, sizeof(char*), compareStrings);
+	}
+	return sp->order[k];
+}
+
+/*Returns the number of strings in set sp that are not less than lo and less than hi, and stores the rank of the first of them in first. Either bound may be null to leave that end of the range open. Since data isn't sorted, both are counted with one pass over it.
+ *Big-O notation: O(n)
+ */
+int findRange(SET *sp, char *lo, char *hi, int *first)
+{
+	assert(sp != NULL);
+	assert(first != NULL);
+	int i, below = 0, count = 0;
+	for(i = 0; i < sp->count; i++)
+	{
+		if(lo != NULL && strcmp(sp->data[i], lo) < 0)
+		{
+			below++;
+		}
+		else if(hi == NULL || strcmp(sp->data[i], hi) < 0)
+		{
+			count++;
+		}
+	}
+	*first = below;
+	return count;
+}
+
+/*Returns the number of strings in set sp that start with prefix, and stores the rank of the first of them in first, counting both with one pass over data.
+ *Big-O notation: O(n)
+ */
+int findPrefix(SET *sp, char *prefix, int *first)
+{
+	assert(sp != NULL);
+	assert(prefix != NULL);
+	assert(first != NULL);
+	int i, below = 0, count = 0;
+	int length = strlen(prefix);
+	for(i = 0; i < sp->count; i++)
+	{
+		if(strncmp(sp->data[i], prefix, length) == 0)
+		{
+			count++;
+		}
+		else if(strcmp(sp->data[i], prefix) < 0)
+		{
+			below++;
+		}
+	}
+	*first = below;
+	return count;
+}
+
+/*Does nothing, since only the sorted array in sorted.c is front coded. Kept so callers can use the same entry points for every implementation.
+ *Big-O notation: O(1)
+ */
+void compressSet(SET *sp)
+{
+	assert(sp != NULL);
+}
+
+/*Does nothing, since freezing only changes the layout of the sorted array in sorted.c. Kept so callers can use the same entry points for every implementation.
+ *Big-O notation: O(1)
+ */
+void freezeSet(SET *sp)
+{
+	assert(sp != NULL);
+}
+
 /*Creates a copy of array data and returns the new array. All values in data are the same in the newData array. Assert is used to make sure no pointers passed into the method are null and make sure memory is allocated correclty.
  *Big-O notation: O(n)
  */
@@ -128,21 +416,118 @@ char **getElements(SET *sp)
 	return newData;	
 }
 
-/*Searches the set sp for a given string elt using sequential search. Returns the index of elt in the array data if found, returns -1 if not found. Assert is used to make sure no pointers passed in to method are null. 
+//scan used by search to find the strings whose fingerprints match, which is replaced by the AVX2 version by chooseScan if the processor supports it
+static int (*scan)(SET *sp, char *elt, int length, unsigned char print) = scanPrints;
+
+/*Returns a bit mask of which of the PRINT_WIDTH fingerprints starting at index i of prints are equal to print, with bit j set if prints[i+j] matches. Uses one SSE2 comparison when the build targets it, and otherwise packs 8 fingerprints into an integer and finds the matching bytes with bit tricks.
+ *Big-O notation: O(1)
+ */
+static uint32_t matchPrints(SET *sp, int i, unsigned char print)
+{
+#ifdef __SSE2__
+	__m128i chunk = _mm_loadu_si128((__m128i *)(sp->prints + i));
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(print)));
+#else
+	uint64_t chunk, ones = 0x0101010101010101ULL, highs = 0x8080808080808080ULL;
+	memcpy(&chunk, sp->prints + i, 8);
+	//bytes that match become zero, and the high bit of each zero byte is set without carrying into the next byte
+	chunk ^= ones * print;
+	chunk = ~(((chunk & ~highs) + ~highs) | chunk) & highs;
+	uint32_t mask = 0;
+	int j;
+	for(j = 0; j < 8; j++)
+	{
+		mask |= ((chunk >> (8*j + 7)) & 1) << j;
+	}
+	return mask;
+#endif
+}
+
+/*Looks at the strings of set sp picked out by mask, where bit j stands for index i+j of data, and returns the index of the first one that is elt, or -1 if none is. Only the strings whose length also matches are compared with memcmp.
+ *Big-O notation: O(1)
+ */
+static inline int checkMatches(SET *sp, int i, uint32_t mask, char *elt, int length)
+{
+	int j;
+	while(mask != 0)
+	{
+		j = i + __builtin_ctz(mask);
+		if(sp->lengths[j] == length && memcmp(sp->data[j], elt, length) == 0)
+		{
+			return j;
+		}
+		mask &= mask - 1;
+	}
+	return -1;
+}
+
+/*Scans the fingerprints of set sp PRINT_WIDTH at a time with matchPrints for the ones equal to print, and returns the index of elt in data, or -1 if it is not there. The bits past the end of data in the last chunk are ignored.
  *Big-O notation: O(n)
  */
-static int search(SET *sp, char *elt)
+static int scanPrints(SET *sp, char *elt, int length, unsigned char print)
 {
-	assert(sp != NULL);
-	assert(elt != NULL);
-	int i;
-	//Searches data sequentially to find the index of elt
-	for(i = 0; i < sp->count; i++)
+	int i, j;
+	for(i = 0; i < sp->count; i += PRINT_WIDTH)
 	{
-		if(strcmp(sp->data[i], elt) == 0)
+		uint32_t mask = matchPrints(sp, i, print);
+		if(sp->count - i < PRINT_WIDTH)
 		{
-			return i;			
-		} 		
+			mask &= (1u << (sp->count - i)) - 1;
+		}
+		if((j = checkMatches(sp, i, mask, elt, length)) != -1)
+		{
+			return j;
+		}
 	}
-	return -1; 
+	return -1;
+}
+
+#ifdef HAVE_X86
+/*Same as scanPrints, but compares WIDE_PRINT_WIDTH fingerprints at a time with one AVX2 comparison. Compiled for AVX2 whatever the flags given to the compiler, so it is only used if chooseScan finds that the processor has it.
+ *Big-O notation: O(n)
+ */
+__attribute__((target("avx2")))
+static int scanPrintsAVX2(SET *sp, char *elt, int length, unsigned char print)
+{
+	__m256i prints = _mm256_set1_epi8(print);
+	int i, j;
+	for(i = 0; i < sp->count; i += WIDE_PRINT_WIDTH)
+	{
+		__m256i chunk = _mm256_loadu_si256((__m256i *)(sp->prints + i));
+		uint32_t mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, prints));
+		if(sp->count - i < WIDE_PRINT_WIDTH)
+		{
+			mask &= (1u << (sp->count - i)) - 1;
+		}
+		if((j = checkMatches(sp, i, mask, elt, length)) != -1)
+		{
+			return j;
+		}
+	}
+	return -1;
+}
+#endif
+
+/*Picks the widest fingerprint scan the processor supports: scanPrintsAVX2 if it has AVX2, and otherwise scanPrints, which is SSE2 if the build targets it and the portable version if not.
+ *Big-O notation: O(1)
+ */
+static void chooseScan(void)
+{
+#ifdef HAVE_X86
+	__builtin_cpu_init();
+	if(__builtin_cpu_supports("avx2"))
+	{
+		scan = scanPrintsAVX2;
+	}
+#endif
+}
+
+/*Searches the set sp for a given string elt, whose length is already known. Returns the index of elt in the array data if found, returns -1 if not found. Rather than comparing elt with every string, the fingerprints are compared a chunk at a time by the scan chosen by chooseScan, and only the strings whose fingerprint and length both match are compared with memcmp. With a one-byte hash, about one string in 256 is looked at. Assert is used to make sure no pointers passed in to method are null. 
+ *Big-O notation: O(n)
+ */
+static int search(SET *sp, char *elt, int length)
+{
+	assert(sp != NULL);
+	assert(elt != NULL);
+	return (*scan)(sp, elt, length, fingerprint(elt, length));
 }
@@ -8,13 +8,18 @@
  *
  *              The program takes one file as a command line argument and
  *              counts the number of times each word appears in the file.
+ *              With -f, words are lowercased and stripped of surrounding
+ *              punctuation first.
  */
 
 # include <stdio.h>
 # include <stdlib.h>
 # include <string.h>
 # include <assert.h>
+# include <stdbool.h>
 # include "set.h"
+# include "token.h"
+# include "arena.h"
 
 struct entry {
     char *word;
@@ -22,9 +27,12 @@ struct entry {
 };
 
 
-/* This is sufficient for the test cases in /scratch/coen12. */
+/* This is sufficient for the test cases in /scratch/coen12.  Larger inputs
+   can be run by compiling with -DMAX_SIZE=n. */
 
+# ifndef MAX_SIZE
 # define MAX_SIZE 18000
+# endif
 
 
 /*
@@ -77,40 +85,52 @@ static int compareEntries(struct entry *ep1, struct entry *ep2)
 
 int main(int argc, char *argv[])
 {
-    FILE *fp;
-    char buffer[BUFSIZ];
+    TOKENIZER *tp;
+    char *word;
     struct entry e, *ep, **entries;
     SET *counts;
-    int i;
+    ARENA *words;
+    int i, length;
+    bool fflag = false;
 
 
     /* Check usage and open the file. */
 
+    if (argc == 3 && strcmp(argv[1], "-f") == 0) {
+	fflag = true;
+	argc --;
+	argv[1] = argv[2];
+    }
+
     if (argc != 2) {
-        fprintf(stderr, "usage: %s file\n", argv[0]);
+        fprintf(stderr, "usage: %s [-f] file\n", argv[0]);
         exit(EXIT_FAILURE);
     }
 
-    if ((fp = fopen(argv[1], "r")) == NULL) {
+    if ((tp = openTokenizer(argv[1])) == NULL) {
         fprintf(stderr, "%s: cannot open %s\n", argv[0], argv[1]);
         exit(EXIT_FAILURE);
     }
 
+    foldTokens(tp, fflag);
 
-    /* Increment the count on each word read. */
+
+    /* Increment the count on each word read.  Each distinct word is
+       copied only once, so the copies are packed into an arena that is
+       freed all at once. */
 
     counts = createSet(MAX_SIZE, compareEntries, hashEntry);
+    words = createArena(false);
 
-    while (fscanf(fp, "%s", buffer) == 1) {
-	e.word = buffer;
+    while ((word = nextToken(tp, &length)) != NULL) {
+	e.word = word;
 	ep = findElement(counts, &e);
 
 	if (ep == NULL) {
 	    ep = malloc(sizeof(struct entry));
 	    assert(ep != NULL);
 
-	    ep->word = strdup(buffer);
-	    assert(ep->word != NULL);
+	    ep->word = copyArena(words, word, length);
 
 	    ep->count = 1;
 	    addElement(counts, ep);
@@ -119,6 +139,8 @@ int main(int argc, char *argv[])
 	    ep->count ++;
     }
 
+    closeTokenizer(tp);
+
 
     /* Print out the counts for each word. */
 
@@ -126,11 +148,11 @@ int main(int argc, char *argv[])
 
     for (i = 0; i < numElements(counts); i ++) {
 	printf("%s: %d\n", entries[i]->word, entries[i]->count);
-	free(entries[i]->word);
 	free(entries[i]);
     }
 
     free(entries);
+    destroyArena(words);
 
     destroySet(counts);
     exit(EXIT_SUCCESS);
@@ -11,7 +11,10 @@
  *              are inserted into the set and the counts of total words and
  *              total words in the set are printed.  If the second file is
  *              given then all words in the second file are deleted from
- *              the set and the count printed.
+ *              the set and the count printed.  With -f, words are
+ *              lowercased and stripped of surrounding punctuation first.
+ *              With -p, the files are read and split into words by
+ *              separate threads while the words are being inserted.
  */
 
 # include <stdio.h>
@@ -19,11 +22,16 @@
 # include <string.h>
 # include <stdbool.h>
 # include "set.h"
+# include "token.h"
+# include "pipeline.h"
 
 
-/* This is sufficient for the test cases in /scratch/coen12. */
+/* This is sufficient for the test cases in /scratch/coen12.  Larger inputs
+   can be run by compiling with -DMAX_SIZE=n. */
 
+# ifndef MAX_SIZE
 # define MAX_SIZE 18000
+# endif
 
 
 /*
@@ -52,17 +60,25 @@ static unsigned strhash(char *s)
 
 int main(int argc, char *argv[])
 {
-    FILE *fp;
-    char buffer[BUFSIZ], **elts, *word;
+    TOKENIZER *tp = NULL;
+    PIPELINE *pp = NULL;
+    char *word, *elt, **elts;
     SET *unique;
-    int i, words;
-    bool lflag = false;
+    int i, words, length;
+    bool lflag = false, fflag = false, pflag = false;
 
 
     /* Check usage and open the first file. */
 
-    if (argc > 1 && strcmp(argv[1], "-l") == 0) {
-	lflag = true;
+    while (argc > 1 && (strcmp(argv[1], "-l") == 0 ||
+	    strcmp(argv[1], "-f") == 0 || strcmp(argv[1], "-p") == 0)) {
+	if (strcmp(argv[1], "-l") == 0)
+	    lflag = true;
+	else if (strcmp(argv[1], "-f") == 0)
+	    fflag = true;
+	else
+	    pflag = true;
+
 	argc --;
 
 	for (i = 1; i < argc; i ++)
@@ -70,11 +86,16 @@ int main(int argc, char *argv[])
     }
 
     if (argc == 1 || argc > 3) {
-        fprintf(stderr, "usage: %s [-l] file1 [file2]\n", argv[0]);
+        fprintf(stderr, "usage: %s [-l] [-f] [-p] file1 [file2]\n", argv[0]);
         exit(EXIT_FAILURE);
     }
 
-    if ((fp = fopen(argv[1], "r")) == NULL) {
+    if (pflag)
+        pp = openPipeline(argv[1], fflag);
+    else if ((tp = openTokenizer(argv[1])) != NULL)
+        foldTokens(tp, fflag);
+
+    if (tp == NULL && pp == NULL) {
         fprintf(stderr, "%s: cannot open %s\n", argv[0], argv[1]);
         exit(EXIT_FAILURE);
     }
@@ -85,13 +106,16 @@ int main(int argc, char *argv[])
     words = 0;
     unique = createSet(MAX_SIZE, strcmp, strhash);
 
-    while (fscanf(fp, "%s", buffer) == 1) {
+    while ((word = pflag ? nextWord(pp, &length) : nextToken(tp, &length)) != NULL) {
         words ++;
-	if (!findElement(unique, buffer))
-	    addElement(unique, strdup(buffer));
+	if (!findElement(unique, word))
+	    addElement(unique, copyToken(word, length));
     }
 
-    fclose(fp);
+    if (pflag)
+	closePipeline(pp);
+    else
+	closeTokenizer(tp);
 
     if (!lflag) {
 	printf("%d total words\n", words);
@@ -102,7 +126,12 @@ int main(int argc, char *argv[])
     /* Try to open the second file. */
 
     if (argc == 3) {
-        if ((fp = fopen(argv[2], "r")) == NULL) {
+        if (pflag)
+            pp = openPipeline(argv[2], fflag);
+        else if ((tp = openTokenizer(argv[2])) != NULL)
+            foldTokens(tp, fflag);
+
+        if (tp == NULL && pp == NULL) {
             fprintf(stderr, "%s: cannot open %s\n", argv[0], argv[2]);
             exit(EXIT_FAILURE);
         }
@@ -110,14 +139,17 @@ int main(int argc, char *argv[])
 
         /* Delete all words in the second file. */
 
-        while (fscanf(fp, "%s", buffer) == 1) {
-	    if ((word = findElement(unique, buffer)) != NULL) {
-		removeElement(unique, buffer);
-		free(word);
+        while ((word = pflag ? nextWord(pp, &length) : nextToken(tp, &length)) != NULL) {
+	    if ((elt = findElement(unique, word)) != NULL) {
+		removeElement(unique, word);
+		free(elt);
 	    }
 	}
 
-	fclose(fp);
+	if (pflag)
+	    closePipeline(pp);
+	else
+	    closeTokenizer(tp);
 
 	if (!lflag)
 	    printf("%d remaining words\n", numElements(unique));
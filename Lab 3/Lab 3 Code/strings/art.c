@@ -0,0 +1,911 @@
+/*art.c
+ *Various functions that are used to manipulate a set of strings, like table.c but with the strings held in an adaptive radix tree instead of a hash table. Each level of the tree branches on one byte of the string, so a lookup looks at each byte of the string at most once and its cost depends on the length of the string rather than the number of strings in the set. To keep the tree small, each inner node has one of four sizes, holding up to 4, 16, 48, or 256 children, and grows or shrinks to the next size as children are added or removed. A chain of nodes with only one child each is collapsed into a prefix stored in the node below it, which is known as path compression. A string that ends at an inner node, because it is a prefix of the strings below that node, is kept in the node's own end slot rather than under one of the bytes, so a string with null bytes in it is never confused with a shorter one. The leaves are kept in byte order, with the end slot before every byte, so the strings can be listed in alphabetical order by walking the tree.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "set.h"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define TYPE4 0
+#define TYPE16 1
+#define TYPE48 2
+#define TYPE256 3
+
+//number of prefix bytes stored in a node. Longer prefixes are skipped over during a search and checked when the leaf is reached instead.
+#define MAX_PREFIX 10
+
+//a child pointer with its lowest bit set points to a leaf rather than an inner node, which is possible since malloc never returns an odd address
+#define IS_LEAF(p) (((uintptr_t)(p) & 1) != 0)
+#define TO_LEAF(p) ((LEAF*)((uintptr_t)(p) & ~(uintptr_t)1))
+#define MAKE_LEAF(p) ((void*)((uintptr_t)(p) | 1))
+
+//a leaf holds one string and its length in a single allocation
+typedef struct leaf
+{
+	int length;
+	char key[];
+}LEAF;
+
+//the part shared by every size of inner node: its size, its number of children, its compressed prefix, of which only the first MAX_PREFIX bytes are stored, and the leaf of the string that ends right after the prefix, if there is one, which is not counted in count
+typedef struct node
+{
+	uint8_t type;
+	uint16_t count;
+	int prefixLength;
+	unsigned char prefix[MAX_PREFIX];
+	LEAF *end;
+}NODE;
+
+//up to 4 children, with the bytes leading to them kept in order in keys
+typedef struct node4
+{
+	NODE header;
+	unsigned char keys[4];
+	void *children[4];
+}NODE4;
+
+//up to 16 children, with the bytes leading to them kept in order in keys so that they can be compared all at once
+typedef struct node16
+{
+	NODE header;
+	unsigned char keys[16];
+	void *children[16];
+}NODE16;
+
+//up to 48 children, with index[c] holding one more than the slot in children of the child for byte c, or 0 if there is none
+typedef struct node48
+{
+	NODE header;
+	unsigned char index[256];
+	void *children[48];
+}NODE48;
+
+//up to 256 children, indexed directly by byte
+typedef struct node256
+{
+	NODE header;
+	void *children[256];
+}NODE256;
+
+//definition of the structure set
+typedef struct set
+{
+	void *root;
+	int length;
+	int count;
+}SET;
+
+
+/*Returns byte depth of string elt as an unsigned value, for branching on it. depth must be less than the length of elt, since a string that ends at a node is kept in its end slot instead.
+ *Big-O notation: O(1)
+ */
+static inline unsigned char keyAt(char *elt, int depth)
+{
+	return (unsigned char)elt[depth];
+}
+
+/*Allocates a new empty inner node of the given type. Assert is used to make sure the pointer is not null.
+ *Big-O notation: O(1)
+ */
+static NODE *newNode(int type)
+{
+	static const size_t sizes[] = {sizeof(NODE4), sizeof(NODE16), sizeof(NODE48), sizeof(NODE256)};
+	NODE *np = calloc(1, sizes[type]);
+	assert(np != NULL);
+	np->type = type;
+	return np;
+}
+
+/*Allocates a new leaf holding a copy of string elt, whose length is already known. Assert is used to make sure the pointer is not null.
+ *Big-O notation: O(n) where n is the length of elt
+ */
+static LEAF *newLeaf(char *elt, int length)
+{
+	LEAF *lp = malloc(sizeof(LEAF) + length + 1);
+	assert(lp != NULL);
+	lp->length = length;
+	memcpy(lp->key, elt, length);
+	lp->key[length] = '\0';
+	return lp;
+}
+
+/*Returns whether leaf lp holds string elt of the given length.
+ *Big-O notation: O(n) where n is the length of elt
+ */
+static bool leafMatches(LEAF *lp, char *elt, int length)
+{
+	return lp->length == length && memcmp(lp->key, elt, length) == 0;
+}
+
+/*Copies the count, prefix, and end slot of inner node src into inner node dst, for when a node is replaced by one of another size.
+ *Big-O notation: O(1)
+ */
+static void copyHeader(NODE *dst, NODE *src)
+{
+	dst->count = src->count;
+	dst->prefixLength = src->prefixLength;
+	memcpy(dst->prefix, src->prefix, MAX_PREFIX);
+	dst->end = src->end;
+}
+
+/*Returns a pointer to the slot in inner node np holding the child for byte c, or null if there is no such child. A node of 16 compares c with all of its bytes at once when SSE2 is available.
+ *Big-O notation: O(1)
+ */
+static void **findChild(NODE *np, unsigned char c)
+{
+	int i;
+	if(np->type == TYPE4)
+	{
+		NODE4 *p = (NODE4*)np;
+		for(i = 0; i < np->count; i++)
+		{
+			if(p->keys[i] == c)
+			{
+				return &p->children[i];
+			}
+		}
+	}
+	else if(np->type == TYPE16)
+	{
+		NODE16 *p = (NODE16*)np;
+#ifdef __SSE2__
+		__m128i matches = _mm_cmpeq_epi8(_mm_set1_epi8(c), _mm_loadu_si128((__m128i*)p->keys));
+		int mask = _mm_movemask_epi8(matches) & ((1 << np->count) - 1);
+		if(mask != 0)
+		{
+			return &p->children[__builtin_ctz(mask)];
+		}
+#else
+		for(i = 0; i < np->count; i++)
+		{
+			if(p->keys[i] == c)
+			{
+				return &p->children[i];
+			}
+		}
+#endif
+	}
+	else if(np->type == TYPE48)
+	{
+		NODE48 *p = (NODE48*)np;
+		if(p->index[c] != 0)
+		{
+			return &p->children[p->index[c]-1];
+		}
+	}
+	else
+	{
+		NODE256 *p = (NODE256*)np;
+		if(p->children[c] != NULL)
+		{
+			return &p->children[c];
+		}
+	}
+	return NULL;
+}
+
+/*Returns the leaf with the smallest string below node, which is found by always taking the end slot if it is filled, and the first child otherwise.
+ *Big-O notation: O(n) where n is the length of the string
+ */
+static LEAF *minimum(void *node)
+{
+	int i;
+	while(!IS_LEAF(node))
+	{
+		NODE *np = node;
+		if(np->end != NULL)
+		{
+			return np->end;
+		}
+		if(np->type == TYPE4)
+		{
+			node = ((NODE4*)np)->children[0];
+		}
+		else if(np->type == TYPE16)
+		{
+			node = ((NODE16*)np)->children[0];
+		}
+		else if(np->type == TYPE48)
+		{
+			NODE48 *p = (NODE48*)np;
+			for(i = 0; p->index[i] == 0; i++)
+				;
+			node = p->children[p->index[i]-1];
+		}
+		else
+		{
+			NODE256 *p = (NODE256*)np;
+			for(i = 0; p->children[i] == NULL; i++)
+				;
+			node = p->children[i];
+		}
+	}
+	return TO_LEAF(node);
+}
+
+/*Returns how many bytes of the prefix of inner node np match string elt of the given length starting at depth, counting the whole prefix even past the MAX_PREFIX bytes that are stored. Bytes past those are taken from the smallest string below np, since every string below it shares the prefix. If elt ends partway through the prefix, the number of bytes it has left is returned.
+ *Big-O notation: O(n) where n is the length of the prefix
+ */
+static int prefixMismatch(NODE *np, char *elt, int length, int depth)
+{
+	int i;
+	int limit = np->prefixLength < length - depth ? np->prefixLength : length - depth;
+	int stored = limit < MAX_PREFIX ? limit : MAX_PREFIX;
+	for(i = 0; i < stored; i++)
+	{
+		if(np->prefix[i] != keyAt(elt, depth+i))
+		{
+			return i;
+		}
+	}
+	if(limit > MAX_PREFIX)
+	{
+		LEAF *lp = minimum(np);
+		for(; i < limit; i++)
+		{
+			if(keyAt(lp->key, depth+i) != keyAt(elt, depth+i))
+			{
+				return i;
+			}
+		}
+	}
+	return i;
+}
+
+/*Returns whether the stored bytes of the prefix of inner node np match string elt of the given length starting at depth. elt can't match if it ends before the prefix does. Bytes past the first MAX_PREFIX are not checked, so a match is only a guess that is confirmed when the leaf is reached.
+ *Big-O notation: O(1)
+ */
+static bool checkPrefix(NODE *np, char *elt, int length, int depth)
+{
+	int i;
+	if(length - depth < np->prefixLength)
+	{
+		return false;
+	}
+	int stored = np->prefixLength < MAX_PREFIX ? np->prefixLength : MAX_PREFIX;
+	for(i = 0; i < stored; i++)
+	{
+		if(np->prefix[i] != keyAt(elt, depth+i))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/*Adds child to inner node np, which is pointed to by ref, as the child for byte c. A full node is first replaced with one of the next size, and ref is updated to point to the new node.
+ *Big-O notation: O(1)
+ */
+static void addChild(void **ref, NODE *np, unsigned char c, void *child)
+{
+	int i;
+	if(np->type == TYPE4 && np->count < 4)
+	{
+		NODE4 *p = (NODE4*)np;
+		for(i = 0; i < np->count && p->keys[i] < c; i++)
+			;
+		memmove(&p->keys[i+1], &p->keys[i], np->count-i);
+		memmove(&p->children[i+1], &p->children[i], sizeof(void*)*(np->count-i));
+		p->keys[i] = c;
+		p->children[i] = child;
+		np->count++;
+	}
+	else if(np->type == TYPE4)
+	{
+		//grows to a node of 16, which keeps its bytes in the same sorted order
+		NODE4 *p = (NODE4*)np;
+		NODE16 *q = (NODE16*)newNode(TYPE16);
+		copyHeader(&q->header, np);
+		memcpy(q->keys, p->keys, 4);
+		memcpy(q->children, p->children, sizeof(void*)*4);
+		*ref = q;
+		free(p);
+		addChild(ref, &q->header, c, child);
+	}
+	else if(np->type == TYPE16 && np->count < 16)
+	{
+		NODE16 *p = (NODE16*)np;
+		for(i = 0; i < np->count && p->keys[i] < c; i++)
+			;
+		memmove(&p->keys[i+1], &p->keys[i], np->count-i);
+		memmove(&p->children[i+1], &p->children[i], sizeof(void*)*(np->count-i));
+		p->keys[i] = c;
+		p->children[i] = child;
+		np->count++;
+	}
+	else if(np->type == TYPE16)
+	{
+		//grows to a node of 48, which indexes its children by byte instead
+		NODE16 *p = (NODE16*)np;
+		NODE48 *q = (NODE48*)newNode(TYPE48);
+		copyHeader(&q->header, np);
+		for(i = 0; i < 16; i++)
+		{
+			q->index[p->keys[i]] = i + 1;
+			q->children[i] = p->children[i];
+		}
+		*ref = q;
+		free(p);
+		addChild(ref, &q->header, c, child);
+	}
+	else if(np->type == TYPE48 && np->count < 48)
+	{
+		//removals can leave holes in children, so the first free slot is used
+		NODE48 *p = (NODE48*)np;
+		for(i = 0; p->children[i] != NULL; i++)
+			;
+		p->index[c] = i + 1;
+		p->children[i] = child;
+		np->count++;
+	}
+	else if(np->type == TYPE48)
+	{
+		//grows to a node of 256, which holds its children directly by byte
+		NODE48 *p = (NODE48*)np;
+		NODE256 *q = (NODE256*)newNode(TYPE256);
+		copyHeader(&q->header, np);
+		for(i = 0; i < 256; i++)
+		{
+			if(p->index[i] != 0)
+			{
+				q->children[i] = p->children[p->index[i]-1];
+			}
+		}
+		*ref = q;
+		free(p);
+		addChild(ref, &q->header, c, child);
+	}
+	else
+	{
+		NODE256 *p = (NODE256*)np;
+		p->children[c] = child;
+		np->count++;
+	}
+}
+
+/*Replaces node of 4 p, which is pointed to by ref, with what it is left holding once it holds only one string or child. That is the leaf in its end slot if it has no children, and otherwise its one child, with the node's prefix and the byte leading to the child added to the front of the child's prefix. A node holding more than that is left alone.
+ *Big-O notation: O(1)
+ */
+static void collapse(void **ref, NODE4 *p)
+{
+	NODE *np = &p->header;
+	if(np->count == 0)
+	{
+		*ref = MAKE_LEAF(np->end);
+		free(p);
+		return;
+	}
+	if(np->count > 1 || np->end != NULL)
+	{
+		return;
+	}
+
+	void *child = p->children[0];
+	if(!IS_LEAF(child))
+	{
+		//the merged prefix is this node's prefix, then the byte leading to the child, then the child's prefix, of which only the first MAX_PREFIX bytes are kept
+		NODE *cp = child;
+		int length = np->prefixLength;
+		if(length < MAX_PREFIX)
+		{
+			np->prefix[length++] = p->keys[0];
+		}
+		if(length < MAX_PREFIX)
+		{
+			int sub = cp->prefixLength < MAX_PREFIX - length ? cp->prefixLength : MAX_PREFIX - length;
+			memcpy(&np->prefix[length], cp->prefix, sub);
+			length += sub;
+		}
+		memcpy(cp->prefix, np->prefix, length < MAX_PREFIX ? length : MAX_PREFIX);
+		cp->prefixLength += np->prefixLength + 1;
+	}
+	*ref = child;
+	free(p);
+}
+
+/*Removes the child in slot of inner node np, which is pointed to by ref and leads to it by byte c. A node left with few enough children is replaced with one of the next smaller size, and a node of 4 left holding a single string or child is replaced by it with collapse.
+ *Big-O notation: O(1)
+ */
+static void removeChild(void **ref, NODE *np, unsigned char c, void **slot)
+{
+	int i, j;
+	if(np->type == TYPE4)
+	{
+		NODE4 *p = (NODE4*)np;
+		i = slot - p->children;
+		memmove(&p->keys[i], &p->keys[i+1], np->count-i-1);
+		memmove(&p->children[i], &p->children[i+1], sizeof(void*)*(np->count-i-1));
+		np->count--;
+		collapse(ref, p);
+	}
+	else if(np->type == TYPE16)
+	{
+		NODE16 *p = (NODE16*)np;
+		i = slot - p->children;
+		memmove(&p->keys[i], &p->keys[i+1], np->count-i-1);
+		memmove(&p->children[i], &p->children[i+1], sizeof(void*)*(np->count-i-1));
+		np->count--;
+		if(np->count == 3)
+		{
+			NODE4 *q = (NODE4*)newNode(TYPE4);
+			copyHeader(&q->header, np);
+			memcpy(q->keys, p->keys, 3);
+			memcpy(q->children, p->children, sizeof(void*)*3);
+			*ref = q;
+			free(p);
+		}
+	}
+	else if(np->type == TYPE48)
+	{
+		NODE48 *p = (NODE48*)np;
+		p->children[p->index[c]-1] = NULL;
+		p->index[c] = 0;
+		np->count--;
+		if(np->count == 12)
+		{
+			NODE16 *q = (NODE16*)newNode(TYPE16);
+			copyHeader(&q->header, np);
+			for(i = 0, j = 0; i < 256; i++)
+			{
+				if(p->index[i] != 0)
+				{
+					q->keys[j] = i;
+					q->children[j++] = p->children[p->index[i]-1];
+				}
+			}
+			*ref = q;
+			free(p);
+		}
+	}
+	else
+	{
+		NODE256 *p = (NODE256*)np;
+		p->children[c] = NULL;
+		np->count--;
+		if(np->count == 37)
+		{
+			NODE48 *q = (NODE48*)newNode(TYPE48);
+			copyHeader(&q->header, np);
+			for(i = 0, j = 0; i < 256; i++)
+			{
+				if(p->children[i] != NULL)
+				{
+					q->index[i] = j + 1;
+					q->children[j++] = p->children[i];
+				}
+			}
+			*ref = q;
+			free(p);
+		}
+	}
+}
+
+/*Puts leaf, whose string has the given length, into inner node np, which is pointed to by ref and branches at depth. It goes in the end slot if its string ends at depth, and under its byte at depth otherwise.
+ *Big-O notation: O(1)
+ */
+static void placeLeaf(void **ref, NODE *np, void *leaf, int length, int depth)
+{
+	if(length == depth)
+	{
+		np->end = TO_LEAF(leaf);
+	}
+	else
+	{
+		addChild(ref, np, keyAt(TO_LEAF(leaf)->key, depth), leaf);
+	}
+}
+
+/*Inserts a copy of elt, whose length is already known, into the subtree pointed to by ref, whose nodes branch on the bytes of elt starting at depth. A leaf holding another string is replaced by a node of 4 holding both, with the bytes they share as its prefix, and a node whose prefix doesn't match elt is split where they differ. A string that ends where a node branches goes in its end slot. Returns whether elt was inserted, which it isn't if it is already there.
+ *Big-O notation: O(n) where n is the length of elt
+ */
+static bool insert(void **ref, char *elt, int length, int depth)
+{
+	void *node = *ref;
+	if(node == NULL)
+	{
+		*ref = MAKE_LEAF(newLeaf(elt, length));
+		return true;
+	}
+
+	if(IS_LEAF(node))
+	{
+		LEAF *lp = TO_LEAF(node);
+		if(leafMatches(lp, elt, length))
+		{
+			return false;
+		}
+
+		//the shared bytes stop where the strings differ or where the shorter one ends, which only one of them can do since they aren't equal
+		NODE *np = newNode(TYPE4);
+		int i;
+		int limit = lp->length < length ? lp->length - depth : length - depth;
+		for(i = 0; i < limit && keyAt(lp->key, depth+i) == keyAt(elt, depth+i); i++)
+			;
+		np->prefixLength = i;
+		memcpy(np->prefix, elt + depth, i < MAX_PREFIX ? i : MAX_PREFIX);
+		*ref = np;
+		placeLeaf(ref, np, node, lp->length, depth+i);
+		placeLeaf(ref, np, MAKE_LEAF(newLeaf(elt, length)), length, depth+i);
+		return true;
+	}
+
+	NODE *np = node;
+	if(np->prefixLength > 0)
+	{
+		int p = prefixMismatch(np, elt, length, depth);
+		if(p < np->prefixLength)
+		{
+			//splits the prefix with a new node of 4 above np, holding the bytes before the mismatch
+			NODE *parent = newNode(TYPE4);
+			parent->prefixLength = p;
+			memcpy(parent->prefix, np->prefix, p < MAX_PREFIX ? p : MAX_PREFIX);
+			*ref = parent;
+
+			unsigned char c;
+			if(np->prefixLength <= MAX_PREFIX)
+			{
+				c = np->prefix[p];
+				np->prefixLength -= p + 1;
+				memmove(np->prefix, np->prefix + p + 1, np->prefixLength);
+			}
+			else
+			{
+				//the bytes past the stored ones have to come from a string below np
+				LEAF *lp = minimum(np);
+				c = keyAt(lp->key, depth+p);
+				np->prefixLength -= p + 1;
+				memcpy(np->prefix, lp->key + depth + p + 1, np->prefixLength < MAX_PREFIX ? np->prefixLength : MAX_PREFIX);
+			}
+			addChild(ref, parent, c, np);
+			placeLeaf(ref, parent, MAKE_LEAF(newLeaf(elt, length)), length, depth+p);
+			return true;
+		}
+		depth += np->prefixLength;
+	}
+
+	if(length == depth)
+	{
+		if(np->end != NULL)
+		{
+			return false;
+		}
+		np->end = newLeaf(elt, length);
+		return true;
+	}
+	void **child = findChild(np, keyAt(elt, depth));
+	if(child != NULL)
+	{
+		return insert(child, elt, length, depth+1);
+	}
+	addChild(ref, np, keyAt(elt, depth), MAKE_LEAF(newLeaf(elt, length)));
+	return true;
+}
+
+/*Removes elt, whose length is already known, from the subtree pointed to by ref, whose nodes branch on the bytes of elt starting at depth. Returns whether elt was found.
+ *Big-O notation: O(n) where n is the length of elt
+ */
+static bool removeKey(void **ref, char *elt, int length, int depth)
+{
+	void *node = *ref;
+	if(node == NULL)
+	{
+		return false;
+	}
+
+	//only the root can be a leaf here, since below it leaves are removed by their parents
+	if(IS_LEAF(node))
+	{
+		if(!leafMatches(TO_LEAF(node), elt, length))
+		{
+			return false;
+		}
+		free(TO_LEAF(node));
+		*ref = NULL;
+		return true;
+	}
+
+	NODE *np = node;
+	if(np->prefixLength > 0)
+	{
+		if(!checkPrefix(np, elt, length, depth))
+		{
+			return false;
+		}
+		depth += np->prefixLength;
+	}
+
+	if(length == depth)
+	{
+		if(np->end == NULL || !leafMatches(np->end, elt, length))
+		{
+			return false;
+		}
+		free(np->end);
+		np->end = NULL;
+		//only a node of 4 can be left holding a single child
+		if(np->type == TYPE4)
+		{
+			collapse(ref, (NODE4*)np);
+		}
+		return true;
+	}
+
+	unsigned char c = keyAt(elt, depth);
+	void **child = findChild(np, c);
+	if(child == NULL)
+	{
+		return false;
+	}
+	if(IS_LEAF(*child))
+	{
+		LEAF *lp = TO_LEAF(*child);
+		if(!leafMatches(lp, elt, length))
+		{
+			return false;
+		}
+		free(lp);
+		removeChild(ref, np, c, child);
+		return true;
+	}
+	return removeKey(child, elt, length, depth+1);
+}
+
+/*Frees the subtree rooted at node, along with every leaf in it.
+ *Big-O notation: O(n)
+ */
+static void freeTree(void *node)
+{
+	int i;
+	if(node == NULL)
+	{
+		return;
+	}
+	if(IS_LEAF(node))
+	{
+		free(TO_LEAF(node));
+		return;
+	}
+
+	NODE *np = node;
+	free(np->end);
+	if(np->type == TYPE4)
+	{
+		for(i = 0; i < np->count; i++)
+		{
+			freeTree(((NODE4*)np)->children[i]);
+		}
+	}
+	else if(np->type == TYPE16)
+	{
+		for(i = 0; i < np->count; i++)
+		{
+			freeTree(((NODE16*)np)->children[i]);
+		}
+	}
+	else if(np->type == TYPE48)
+	{
+		for(i = 0; i < 48; i++)
+		{
+			freeTree(((NODE48*)np)->children[i]);
+		}
+	}
+	else
+	{
+		for(i = 0; i < 256; i++)
+		{
+			freeTree(((NODE256*)np)->children[i]);
+		}
+	}
+	free(np);
+}
+
+/*Adds the string of every leaf below node to the array elts in alphabetical order, starting at index *next. The string in the end slot of a node comes first, since it comes before every longer string that starts with it, and then the children are visited in order of their bytes.
+ *Big-O notation: O(n)
+ */
+static void collect(void *node, char **elts, int *next)
+{
+	int i;
+	if(IS_LEAF(node))
+	{
+		elts[(*next)++] = TO_LEAF(node)->key;
+		return;
+	}
+
+	NODE *np = node;
+	if(np->end != NULL)
+	{
+		elts[(*next)++] = np->end->key;
+	}
+	if(np->type == TYPE4)
+	{
+		for(i = 0; i < np->count; i++)
+		{
+			collect(((NODE4*)np)->children[i], elts, next);
+		}
+	}
+	else if(np->type == TYPE16)
+	{
+		for(i = 0; i < np->count; i++)
+		{
+			collect(((NODE16*)np)->children[i], elts, next);
+		}
+	}
+	else if(np->type == TYPE48)
+	{
+		NODE48 *p = (NODE48*)np;
+		for(i = 0; i < 256; i++)
+		{
+			if(p->index[i] != 0)
+			{
+				collect(p->children[p->index[i]-1], elts, next);
+			}
+		}
+	}
+	else
+	{
+		NODE256 *p = (NODE256*)np;
+		for(i = 0; i < 256; i++)
+		{
+			if(p->children[i] != NULL)
+			{
+				collect(p->children[i], elts, next);
+			}
+		}
+	}
+}
+
+/*Creates the set, taking in an argument maxElts that represents the maximum number of words that can be stored in the set. The tree starts out empty, and nodes are only allocated as strings are added. Assert is used to make sure that none of the pointers used are null.
+ *Big-O notation: O(1)
+ */
+SET *createSet(int maxElts)
+{
+	SET *setptr = malloc(sizeof(SET));
+	assert(setptr != NULL);
+	setptr->root = NULL;
+	setptr->length = maxElts;
+	setptr->count = 0;
+	return setptr;
+}
+
+/*Same as createSet, since the tree branches on the bytes of each string and never hashes them, so hash is ignored.
+ *Big-O notation: O(1)
+ */
+SET *createSetHash(int maxElts, unsigned (*hash)(char *string, int length))
+{
+	return createSet(maxElts);
+}
+
+/*Deallocates memory from inputted set sp, freeing every node and leaf of the tree, and then the set sp itself. Assert is used to make sure none of the pointers used are null.
+ *Big-O notation: O(n)
+ */
+void destroySet(SET *sp)
+{
+	assert(sp != NULL);
+	freeTree(sp->root);
+	free(sp);
+}
+
+/*Finds and returns the number of elements currently stored in the set by accessing the variable count. Assert is used to make sure none of the pointers used are null.
+ *Big-O notation: O(1)
+ */
+int numElements(SET *sp)
+{
+	assert(sp != NULL);
+	return sp->count;
+}
+
+/*Adds an inputted string elt into set sp. Measures elt and passes it to addElementLen. Assert is used to make sure none of the pointers used are null.
+ *Big-O notation: O(n) where n is the length of elt
+ */
+void addElement(SET *sp, char *elt)
+{
+	assert(elt != NULL);
+	addElementLen(sp, elt, strlen(elt));
+}
+
+/*Same as addElement, but takes the length of elt from the caller so that it doesn't have to be measured again. Assert is used to make sure none of the pointers used are null and that the set is not already holding its maximum number of elements.
+ *Big-O notation: O(n) where n is the length of elt
+ */
+void addElementLen(SET *sp, char *elt, int length)
+{
+	assert(sp != NULL);
+	assert(elt != NULL);
+	if(insert(&sp->root, elt, length, 0))
+	{
+		sp->count++;
+		assert(sp->count <= sp->length);
+	}
+}
+
+/*Removes inputted string elt from the set sp if it is there. Measures elt and passes it to removeElementLen. Assert is used to make sure none of the pointers used are null.
+ *Big-O notation: O(n) where n is the length of elt
+ */
+void removeElement(SET *sp, char *elt)
+{
+	assert(elt != NULL);
+	removeElementLen(sp, elt, strlen(elt));
+}
+
+/*Same as removeElement, but takes the length of elt from the caller. Assert is used to make sure none of the pointers used are null.
+ *Big-O notation: O(n) where n is the length of elt
+ */
+void removeElementLen(SET *sp, char *elt, int length)
+{
+	assert(sp != NULL);
+	assert(elt != NULL);
+	if(removeKey(&sp->root, elt, length, 0))
+	{
+		sp->count--;
+	}
+}
+
+/*Finds inputted string elt in set sp. Measures elt and passes it to findElementLen. Returns null if string isn't found. Assert is used to make sure no pointers passed in to the method are null.
+ *Big-O notation: O(n) where n is the length of elt
+ */
+char *findElement(SET *sp, char *elt)
+{
+	assert(elt != NULL);
+	return findElementLen(sp, elt, strlen(elt));
+}
+
+/*Same as findElement, but takes the length of elt from the caller. Follows the bytes of elt down the tree, skipping over the prefix of each node after checking its stored bytes, until a leaf is reached, and then compares elt with the string in the leaf, which also checks any prefix bytes that were skipped. Returns null if string isn't found.
+ *Big-O notation: O(n) where n is the length of elt
+ */
+char *findElementLen(SET *sp, char *elt, int length)
+{
+	assert(sp != NULL);
+	assert(elt != NULL);
+	void *node = sp->root;
+	int depth = 0;
+	while(node != NULL)
+	{
+		if(IS_LEAF(node))
+		{
+			LEAF *lp = TO_LEAF(node);
+			return leafMatches(lp, elt, length) ? lp->key : NULL;
+		}
+
+		NODE *np = node;
+		if(np->prefixLength > 0)
+		{
+			if(!checkPrefix(np, elt, length, depth))
+			{
+				return NULL;
+			}
+			depth += np->prefixLength;
+		}
+
+		if(length == depth)
+		{
+			return (np->end != NULL && leafMatches(np->end, elt, length)) ? np->end->key : NULL;
+		}
+		void **child = findChild(np, keyAt(elt, depth));
+		node = child != NULL ? *child : NULL;
+		depth++;
+	}
+	return NULL;
+}
+
+/*Returns a new array holding every string in the set in alphabetical order, found by walking the tree. Assert is used to make sure no pointers passed into the method are null and make sure memory is allocated correctly.
+ *Big-O notation: O(n)
+ */
+char **getElements(SET *sp)
+{
+	assert(sp != NULL);
+	char **newData = malloc(sizeof(char*)*sp->count);
+	assert(newData != NULL || sp->count == 0);
+	int next = 0;
+	if(sp->root != NULL)
+	{
+		collect(sp->root, newData, &next);
+	}
+	assert(next == sp->count);
+	return newData;
+}
@@ -9,18 +9,27 @@
  *              The program takes a single file as a command line argument.
  *              A set is used to maintain a collection of words that occur
  *              an odd number of times.  The counts of total words and
- *              words appearing an odd number of times are printed.
+ *              words appearing an odd number of times are printed.  With
+ *              -f, words are lowercased and stripped of surrounding
+ *              punctuation first.  With -h, the set hashes words with the
+ *              named function from hash.h instead of its own.
  */
 
 # include <stdio.h>
 # include <stdlib.h>
 # include <string.h>
+# include <stdbool.h>
 # include "set.h"
+# include "token.h"
+# include "hash.h"
 
 
-/* This is sufficient for the test cases in /scratch/coen12. */
+/* This is sufficient for the test cases in /scratch/coen12.  Larger inputs
+   can be run by compiling with -DMAX_SIZE=n. */
 
+# ifndef MAX_SIZE
 # define MAX_SIZE 18000
+# endif
 
 
 /*
@@ -31,41 +40,65 @@
 
 int main(int argc, char *argv[])
 {
-    FILE *fp;
-    char buffer[BUFSIZ];
+    TOKENIZER *tp;
+    char *word;
     SET *odd;
-    int words;
+    int i, words, length, shift;
+    bool fflag = false;
+    HASHFUNC *hash = NULL;
 
 
     /* Check usage and open the file. */
 
+    while (argc > 1 && (strcmp(argv[1], "-f") == 0 ||
+	    strcmp(argv[1], "-h") == 0)) {
+	shift = 1;
+
+	if (strcmp(argv[1], "-f") == 0)
+	    fflag = true;
+	else if (argc > 2 && (hash = findHash(argv[2])) != NULL)
+	    shift = 2;
+	else {
+	    argc = 1;
+	    break;
+	}
+
+	argc -= shift;
+
+	for (i = 1; i < argc; i ++)
+	    argv[i] = argv[i + shift];
+    }
+
     if (argc != 2) {
-        fprintf(stderr, "usage: %s file1\n", argv[0]);
+        fprintf(stderr, "usage: %s [-f] [-h multiply|wide|crc] file1\n",
+	    argv[0]);
         exit(EXIT_FAILURE);
     }
 
-    if ((fp = fopen(argv[1], "r")) == NULL) {
+    if ((tp = openTokenizer(argv[1])) == NULL) {
         fprintf(stderr, "%s: cannot open %s\n", argv[0], argv[1]);
         exit(EXIT_FAILURE);
     }
 
+    foldTokens(tp, fflag);
+
 
     /* Insert or delete words to compute their parity. */
 
     words = 0;
-    odd = createSet(MAX_SIZE);
+    odd = hash != NULL ? createSetHash(MAX_SIZE, hash) : createSet(MAX_SIZE);
 
-    while (fscanf(fp, "%s", buffer) == 1) {
+    while ((word = nextToken(tp, &length)) != NULL) {
         words ++;
-        if (findElement(odd, buffer))
-            removeElement(odd, buffer);
+        if (findElementLen(odd, word, length))
+            removeElementLen(odd, word, length);
         else
-            addElement(odd, buffer);
+            addElementLen(odd, word, length);
     }
 
     printf("%d total words\n", words);
     printf("%d words occur an odd number of times\n", numElements(odd));
-    fclose(fp);
+    closeTokenizer(tp);
 
     destroySet(odd);
     exit(EXIT_SUCCESS);
@@ -0,0 +1,243 @@
+/*robin.c
+ *Various functions that are used to manipulate a set of strings, like table.c but with the hash table using Robin Hood linear probing instead of deleted flags. The distance of a string from the slot it hashes to is its probe distance, and a string being inserted takes the slot of any string it passes that is closer to its own slot than the new string is to its slot, with the displaced string then inserted further along in the same way. This keeps every string about as far from its slot as every other, and keeps the strings in each run of filled slots in order of the slots they hash to, so a search can stop as soon as it passes a string closer to its slot than elt would be. A removed string is not marked as deleted. Instead the strings after it are shifted back one slot each until one is reached that is already in its own slot, so the table holds no deleted slots that later searches have to probe past, and the probe distances stay the same no matter how many strings are added and removed.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "set.h"
+#include "arena.h"
+#include "hash.h"
+#include <stdbool.h>
+
+static int search(SET *sp, char *elt, unsigned hash, bool *found);
+static int distance(SET *sp, int location);
+
+//definition of the structure set. An empty slot has a null pointer in data, and each filled slot has the hash of its string in hashes, so that probe distances can be found and most mismatches rejected without looking at the strings. The strings themselves are all copied into arena, which interns them so that a string that is removed and added again reuses its old copy.
+typedef struct set
+{
+	char **data;
+	unsigned *hashes;
+	ARENA *arena;
+	int length;
+	int count;
+	unsigned (*hash)(char *string, int length);
+}SET;
+
+/*Creates the set, taking in an argument maxElts that represents the maximum number of words that can be stored in the array data. The set and arrays data and hashes are allocated the appropriate amount of memory, with every slot of data set to null since no values have been inserted into the hash table at this time. Strings are hashed with hashMultiply from hash.h. Assert is used to make sure that none of the pointers used are null.
+ *Big-O notation: O(n)   where n = maxElts  (max length of the array data)
+ */
+SET *createSet(int maxElts)
+{
+	return createSetHash(maxElts, hashMultiply);
+}
+
+/*Same as createSet, but takes the function hash used to hash each string and its length. Assert is used to make sure that none of the pointers used are null.
+ *Big-O notation: O(n)   where n = maxElts  (max length of the array data)
+ */
+SET *createSetHash(int maxElts, unsigned (*hash)(char *string, int length))
+{
+	assert(hash != NULL);
+	SET *setptr = malloc(sizeof(SET));
+	assert(setptr != NULL);
+	setptr->length = maxElts;
+	setptr->data = calloc(maxElts, sizeof(char*));
+	assert(setptr->data != NULL);
+	setptr->hashes = malloc(sizeof(unsigned)*maxElts);
+	assert(setptr->hashes != NULL);
+	setptr->arena = createArena(true);
+	setptr->count = 0;
+	setptr->hash = hash;
+	return setptr;
+}
+
+/*Deallocates the memory given to inputted set sp. First deallocates every string at once by destroying the arena, and then deallocates the arrays data and hashes and the set sp itself. Assert is used to make sure none of the pointers used are null.
+ *Big-O notation: O(1)
+ */
+void destroySet(SET *sp)
+{
+	assert(sp != NULL);
+	destroyArena(sp->arena);
+	free(sp->data);
+	free(sp->hashes);
+	free(sp);
+}
+
+/*Finds and returns the number of elements currently stored in the set by accessing the variable count. Assert is used to make sure none of the pointers used are null.
+ *Big-O notation: O(1)
+ */
+int numElements(SET *sp)
+{
+	assert(sp != NULL);
+	return sp->count;
+}
+
+/*Adds an inputted string elt into the array data of set sp. Measures elt and passes it to addElementLen. Assert is used to make sure none of the pointers used are null.
+ *Big-O notation: O(n)   where n = maxElts  (max length of the array data)
+ */
+void addElement(SET *sp, char *elt)
+{
+	assert(elt != NULL);
+	addElementLen(sp, elt, strlen(elt));
+}
+
+/*Same as addElement, but takes the length of elt from the caller so that elt can be hashed and copied without measuring it again. The copy of elt is placed in the slot where the search stopped, and the string that was there, if any, is carried along to the next slot, taking the slot of the first string it passes that is closer to its own slot than it is, and so on until an empty slot is reached. Assert is used to make sure none of the pointers used are null and that the set is not already holding its maximum number of elements.
+ *Big-O notation: O(n)   where n = maxElts  (max length of the array data)
+ */
+void addElementLen(SET *sp, char *elt, int length)
+{
+	assert(sp != NULL);
+	assert(elt != NULL);
+	assert(sp->count < sp->length);
+	bool found;
+	unsigned hash = (*sp->hash)(elt, length);
+	int location = search(sp, elt, hash, &found);
+	//checks to see if elt is already in the set
+	if(found)
+	{
+		return;
+	}
+
+	char *carried = copyArena(sp->arena, elt, length);
+	int dist = (location - (int)(hash % sp->length) + sp->length) % sp->length;
+	while(sp->data[location] != NULL)
+	{
+		//swaps the carried string with the one in this slot if that one is closer to its own slot
+		int other = distance(sp, location);
+		if(other < dist)
+		{
+			char *string = sp->data[location];
+			unsigned stringHash = sp->hashes[location];
+			sp->data[location] = carried;
+			sp->hashes[location] = hash;
+			carried = string;
+			hash = stringHash;
+			dist = other;
+		}
+		location = (location + 1) % sp->length;
+		dist++;
+	}
+	sp->data[location] = carried;
+	sp->hashes[location] = hash;
+	sp->count++;
+}
+
+/*Removes inputted string elt from the set sp. Measures elt and passes it to removeElementLen. Assert is used to make sure none of the pointers used are null.
+ *Big-O notation: O(n)  where n = maxElts  (max length of the array data)
+ */
+void removeElement(SET *sp, char *elt)
+{
+	assert(elt != NULL);
+	removeElementLen(sp, elt, strlen(elt));
+}
+
+/*Same as removeElement, but takes the length of elt from the caller. Makes sure that elt exists in the set first before removing. Each string after elt is then shifted back one slot until an empty slot or a string already in its own slot is reached, and the last slot shifted from is emptied. The string itself stays in the arena until the set is destroyed. Assert is used to make sure none of the pointers used are null.
+ *Big-O notation: O(n)  where n = maxElts  (max length of the array data)
+ */
+void removeElementLen(SET *sp, char *elt, int length)
+{
+	assert(sp != NULL);
+	assert(elt != NULL);
+	bool found;
+	int location = search(sp, elt, (*sp->hash)(elt, length), &found);
+	//checks to see if elt is in the set, ending the function early if it is not in the set
+	if(!found)
+	{
+		return;
+	}
+
+	int next = (location + 1) % sp->length;
+	while(sp->data[next] != NULL && distance(sp, next) > 0)
+	{
+		sp->data[location] = sp->data[next];
+		sp->hashes[location] = sp->hashes[next];
+		location = next;
+		next = (next + 1) % sp->length;
+	}
+	sp->data[location] = NULL;
+	sp->count--;
+}
+
+/*Finds inputted string elt in set sp. Measures elt and passes it to findElementLen. Returns null if string isn't found. Assert is used to make sure no pointers passed in to the method are null.
+ *Big-O notation: O(n)    where n = maxElts  (max length of the array data)
+ */
+char *findElement(SET *sp, char *elt)
+{
+	assert(elt != NULL);
+	return findElementLen(sp, elt, strlen(elt));
+}
+
+/*Same as findElement, but takes the length of elt from the caller. Uses search function to find the matching string, and then returns that string. Returns null if string isn't found. Assert is used to make sure no pointers passed in to the method are null.
+ *Big-O notation: O(n)    where n = maxElts  (max length of the array data)
+ */
+char *findElementLen(SET *sp, char *elt, int length)
+{
+	assert(sp != NULL);
+	assert(elt != NULL);
+	bool found;
+	int location = search(sp, elt, (*sp->hash)(elt, length), &found);
+	if(found)
+	{
+		return sp->data[location];
+	}
+	return NULL;
+}
+
+/*Creates a copy of array data that only contains the filled values in data and none of the empty values. A for loop is used to find the filled locations and adds the values of those locations to newData. Assert is used to make sure no pointers passed into the method are null and make sure memory is allocated correctly.
+ *Big-O notation: O(n)    where n = maxElts  (max length of the array data)
+ */
+char **getElements(SET *sp)
+{
+	assert(sp != NULL);
+	char **newData = malloc(sizeof(char*)*sp->count);
+	assert(newData != NULL);
+	int dataIndex;
+	int newDataIndex = 0;
+	for(dataIndex = 0; dataIndex < sp->length; dataIndex++)
+	{
+		if(sp->data[dataIndex] != NULL)
+		{
+			newData[newDataIndex] = sp->data[dataIndex];
+			newDataIndex++;
+		}
+	}
+	return newData;
+}
+
+/*Returns the probe distance of the string in slot location of set sp, which is how many slots past the slot it hashes to it is, wrapping around the end of the table.
+ *Big-O notation: O(1)
+ */
+static int distance(SET *sp, int location)
+{
+	int home = sp->hashes[location] % sp->length;
+	return location >= home ? location - home : location + sp->length - home;
+}
+
+/*Searches the set sp for a given string elt whose hash is hash using linear probing from the slot it hashes to. Since the strings of each run of filled slots are kept in order of the slots they hash to, the search stops at the first empty slot or the first string that is closer to its own slot than elt would be at that point. Strings are only compared if their hashes match. Returns the index of elt in the array data if found or the index of where the element should be placed if not found. A boolean called found is passed in by reference which represents if the element has been found or not. Assert is used to make sure no pointers passed in to method are null.
+ *Big-O notation: O(n)   where n = maxElts  (max length of the array data)
+ */
+static int search(SET *sp, char *elt, unsigned hash, bool *found)
+{
+	assert(sp != NULL);
+	assert(elt != NULL);
+	assert(found != NULL);
+	int location = hash % sp->length;
+	int dist;
+	for(dist = 0; dist < sp->length; dist++)
+	{
+		if(sp->data[location] == NULL || distance(sp, location) < dist)
+		{
+			break;
+		}
+		if(sp->hashes[location] == hash && strcmp(sp->data[location], elt) == 0)
+		{
+			*found = true;
+			return location;
+		}
+		location = (location + 1) % sp->length;
+	}
+
+	*found = false;
+	return location;
+}
@@ -6,6 +6,16 @@
  * Description: This file contains the public function and type
  *              declarations for a set abstract data type for strings.  A
  *              set is an unordered collection of distinct elements.
+ *
+ *              The Len versions of addElement, removeElement, and
+ *              findElement take the length of ELT from the caller (such
+ *              as a tokenizer that already knows it) so the string does
+ *              not have to be measured again.
+ *
+ *              createSetHash is the same as createSet, but takes the
+ *              function used to hash each string and its length, such as
+ *              one of those in hash.h, instead of the default.  A set that
+ *              does not hash its strings ignores it.
  */
 
 # ifndef SET_H
@@ -15,6 +25,8 @@ typedef struct set SET;
 
 SET *createSet(int maxElts);
 
+SET *createSetHash(int maxElts, unsigned (*hash)(char *string, int length));
+
 void destroySet(SET *sp);
 
 int numElements(SET *sp);
@@ -27,4 +39,10 @@ char *findElement(SET *sp, char *elt);
 
 char **getElements(SET *sp);
 
+void addElementLen(SET *sp, char *elt, int length);
+
+void removeElementLen(SET *sp, char *elt, int length);
+
+char *findElementLen(SET *sp, char *elt, int length);
+
 # endif /* SET_H */
@@ -1,5 +1,5 @@
 /*Andrew Vattuone, table.c, 10/11/23
- *Various functions that are used to manipulate an array of strings within a structure. The words of text files are held in a hash table of strings within a set structure along with variables that track the number of elements within the array and the maximum number of elements the array can store. Strings are inserted into the hash table using a hash function, and an array of characters called flags is used to indicate which slots are filled, which are empty, and which had a value deleted from it.   
+ *Various functions that are used to manipulate an array of strings within a structure. The words of text files are held in a hash table of strings within a set structure along with variables that track the number of elements within the array and the maximum number of elements the array can store. Strings are inserted into the hash table using a hash function, and an array of control bytes called flags is used to indicate which slots are filled, which are empty, and which had a value deleted from it. A filled slot's flag holds 7 bits of the hash of its string, so that a search can compare the flags of 16 slots with the 7 bits of the string being looked for all at once, and only compares the strings in the slots whose bits match. Mismatching strings are then almost never compared, even when the table is nearly full. Strings of up to 15 characters, which is most words, are stored in the slots themselves, so finding one takes a single 16-byte compare with no pointer to follow, and only longer strings are copied elsewhere. The full hash of each string is also kept next to it, so a match of the 7 bits that is not a long string being looked for is nearly always rejected without reading the string itself, and the table could be rehashed without hashing its strings again.   
  */
 
 #include <stdio.h>
@@ -7,62 +7,96 @@
 #include <string.h>
 #include <assert.h>
 #include "set.h"
+#include "arena.h"
+#include "hash.h"
 #include <stdbool.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
-#define EMPTY 0
-#define FILLED 1
-#define DELETED 2
+//a filled slot's flag is the 7 bits of its hash given by TAG, so only empty and deleted slots have the high bit set
+#define EMPTY 0x80
+#define DELETED 0xFE
+#define IS_FILLED(flag) (((flag) & 0x80) == 0)
+#define TAG(hash) ((unsigned char)(((hash) * 2654435769u) >> 25))
 
-static int search(SET *sp, char *elt, bool *found);
+//number of flags compared at once
+#define GROUP 16
+
+//size of a slot, and so the longest string stored in one is SLOT_SIZE-1 characters
+#define SLOT_SIZE 16
+#define LONG 0xFF
+
+static int search(SET *sp, char *elt, int length, unsigned hash, bool *found);
+static void setFlag(SET *sp, int location, unsigned char flag);
 unsigned strhash(char *s);
 
-//definition of the structure set
+//definition of a slot of the hash table. A short string is kept in key, followed by zeros, with SLOT_SIZE-1 minus its length in the last byte, so that a string of SLOT_SIZE-1 characters has a zero there to end it. A longer string is copied elsewhere and kept in out, with LONG in the last byte.
+typedef union slot
+{
+	char key[SLOT_SIZE];
+	struct
+	{
+		char *string;
+		int length;
+	}out;
+}SLOT;
+
+//definition of the structure set. Slot i of hashes holds the hash of the string in slot i of data. Strings too long for a slot are copied into arena, which interns them so that a string that is removed and added again reuses its old copy, and which frees them all at once when the set is destroyed.
 typedef struct set
 {
-	char **data;
+	SLOT *data;
+	unsigned *hashes;
+	ARENA *arena;
 	int length;
 	int count;
-	char *flags;
+	unsigned char *flags;
+	unsigned (*hash)(char *string, int length);
 }SET;
 
-/*Creates the set, taking in an argument maxElts that represents the maximum number of words that can be stored in the array data. The set and array data are both allocated the appropriate amount of memory, length is set to maxElts, and count is set to 0. The flags array is allocated the appropriate amount of memory, and each value is initially set to EMPTY using a for loop since no values have been inserted into the hash table at this time. Assert is used to make sure that none of the pointers used are null. 
+static void fillSlot(SLOT *slot, char *elt, int length);
+static char *slotString(SLOT *slot);
+
+/*Creates the set, taking in an argument maxElts that represents the maximum number of words that can be stored in the array data. The set and the arrays data and hashes are both allocated the appropriate amount of memory, length is set to maxElts, and count is set to 0. The flags array is allocated the appropriate amount of memory plus room for a copy of its first GROUP-1 flags at the end, and each value is initially set to EMPTY since no values have been inserted into the hash table at this time. Strings are hashed with hashMultiply, which gives the same values as strhash. Assert is used to make sure that none of the pointers used are null. 
 Big-O notation: O(n)   where n = maxElts  (max length of the array data)
 */ 
 SET *createSet(int maxElts)
 {
+	return createSetHash(maxElts, hashMultiply);
+}
+
+/*Same as createSet, but takes the function hash used to hash each string and its length. Assert is used to make sure that none of the pointers used are null.
+ *Big-O notation: O(n)   where n = maxElts  (max length of the array data)
+ */
+SET *createSetHash(int maxElts, unsigned (*hash)(char *string, int length))
+{
+	assert(hash != NULL);
 	SET *setptr = malloc(sizeof(SET));
 	assert(setptr != NULL);
 	setptr->length = maxElts;
-	setptr->data = malloc(sizeof(char*)*maxElts);
+	setptr->data = malloc(sizeof(SLOT)*maxElts);
 	assert(setptr->data != NULL);
+	setptr->hashes = malloc(sizeof(unsigned)*maxElts);
+	assert(setptr->hashes != NULL);
+	setptr->arena = createArena(true);
 	setptr->count = 0;
-	setptr->flags = malloc(sizeof(char)*maxElts);
+	setptr->flags = malloc(sizeof(char)*(maxElts + GROUP - 1));
 	assert(setptr->flags != NULL);
-	int i; 
-	for(i = 0; i < setptr->length; i++)
-	{
-		setptr->flags[i] = EMPTY;
-	}
+	memset(setptr->flags, EMPTY, maxElts + GROUP - 1);
+	setptr->hash = hash;
 	return setptr;
 }
 
-/*Deallocates the memory given to inputted set sp. First deallocates the memory of each filled location in data using a for loop, and then deallocates the memory given to the data array itself. Afterwards frees the flags array and frees the memory of the set sp itself. Assert is used to make sure none of the pointers used are null.
- * Big-O notation: O(n)    where n = maxElts  (max length of the array data)
+/*Deallocates the memory given to inputted set sp. First deallocates every long string at once by destroying the arena, and then deallocates the memory given to the arrays data and hashes. Afterwards frees the flags array and frees the memory of the set sp itself. Assert is used to make sure none of the pointers used are null.
+ * Big-O notation: O(1)
  */
 void destroySet(SET *sp)
 {
 	assert(sp != NULL);
-	int i;
-	//Frees memory allocated to each filled element in the array data.   
-	for(i = 0; i < sp->length; i++)
-	{
-		if(sp->flags[i] == FILLED)
-		{
-			free(sp->data[i]);
-		}
-	}
+	destroyArena(sp->arena);
 	//frees memory allocated to the data array itself, the memory allocated to the flags array, and the memory allocated to the set sp
 	free(sp->data);
+	free(sp->hashes);
 	free(sp->flags); 
 	free(sp);
 }
@@ -76,67 +110,101 @@ int numElements(SET *sp)
 	return sp->count;
 }
 
-/*Adds an inputted string elt into the array data of set sp. Will prevent elt from being added to the array if the array data is already holding its maximum number of elements, or if the value of elt is already present in the array. Assert is used to make sure none of the pointers used are null.
+/*Adds an inputted string elt into the array data of set sp. Will prevent elt from being added to the array if the array data is already holding its maximum number of elements, or if the value of elt is already present in the array. Measures elt and passes it to addElementLen. Assert is used to make sure none of the pointers used are null.
  *Big-O notation: O(n)   where n = maxElts  (max length of the array data)
  */
 void addElement(SET *sp, char *elt)
+{
+	assert(elt != NULL);
+	addElementLen(sp, elt, strlen(elt));
+}
+
+/*Same as addElement, but takes the length of elt from the caller so that elt can be hashed and copied without measuring it again. Assert is used to make sure none of the pointers used are null.
+ *Big-O notation: O(n)   where n = maxElts  (max length of the array data)
+ */
+void addElementLen(SET *sp, char *elt, int length)
 {
 	assert(sp != NULL);
 	assert(elt != NULL);
 	//checks to see if the set is already holding the maximum number of strings
 	assert(sp->count < sp->length);
 	bool found;
-	int location = search(sp, elt, &found);
+	unsigned hash = (*sp->hash)(elt, length);
+	int location = search(sp, elt, length, hash, &found);
 	//checks to see if elt is already in the set
 	if(found)
 	{
 		return;	
 	}
 	
-	//Adds elt to the array data at the correct location by using strdup. 
-	char *copy = strdup(elt);
-	assert(copy != NULL);
-	sp->data[location] = copy;
-	assert(sp->data[location] != NULL);
-	sp->flags[location] = FILLED;
+	//Adds elt to the array data at the correct location, in the slot itself if it fits and otherwise as a copy in the arena. 
+	if(length < SLOT_SIZE)
+	{
+		fillSlot(&sp->data[location], elt, length);
+	}
+	else
+	{
+		sp->data[location].out.string = copyArena(sp->arena, elt, length);
+		sp->data[location].out.length = length;
+		sp->data[location].key[SLOT_SIZE-1] = LONG;
+	}
+	sp->hashes[location] = hash;
+	setFlag(sp, location, TAG(hash));
 	sp->count++;
 }
 
-/*Removes inputted string elt from the set sp. Makes sure that elt exists in the set first before removing. Assert is used to make sure none of the pointers used are null.  
+/*Removes inputted string elt from the set sp. Measures elt and passes it to removeElementLen. Assert is used to make sure none of the pointers used are null.  
  *Big-O notation: O(n)  where n = maxElts  (max length of the array data)
  */
 void removeElement(SET *sp, char *elt)
+{
+	assert(elt != NULL);
+	removeElementLen(sp, elt, strlen(elt));
+}
+
+/*Same as removeElement, but takes the length of elt from the caller. Makes sure that elt exists in the set first before removing. Assert is used to make sure none of the pointers used are null.  
+ *Big-O notation: O(n)  where n = maxElts  (max length of the array data)
+ */
+void removeElementLen(SET *sp, char *elt, int length)
 {
 	assert(sp != NULL);
 	assert(elt != NULL);
 	//searches set to see if elt is located within the array data
 	bool found;
-	int location = search(sp, elt, &found);
+	int location = search(sp, elt, length, (*sp->hash)(elt, length), &found);
 	//checks to see if elt is in the set, ending the funciton early if it is not in the set
 	if(!found)
 	{
 		return;
 	}
 	
-	//Frees the memory of the value of data at location and sets the corresponding location in flags equal to deleted.  
-	free(sp->data[location]);
-	sp->flags[location] = DELETED; 
+	//Sets the corresponding location in flags equal to deleted. A long string itself stays in the arena until the set is destroyed.  
+	setFlag(sp, location, DELETED);
 	sp->count--; 
 }
 
-/*Finds inputted string elt in set sp. Uses search function to find the matching string, and then returns that string. Returns null if string isn't found. Assert is used to make sure no pointers passed in to the method are null. 
+/*Finds inputted string elt in set sp. Measures elt and passes it to findElementLen. Returns null if string isn't found. Assert is used to make sure no pointers passed in to the method are null. 
  *Big-O notation: O(n)    where n = maxElts  (max length of the array data)
  */
 char *findElement(SET *sp, char *elt)
+{
+	assert(elt != NULL);
+	return findElementLen(sp, elt, strlen(elt));
+}
+
+/*Same as findElement, but takes the length of elt from the caller. Uses search function to find the matching string, and then returns that string, which for a short string is the copy in its slot. Returns null if string isn't found. Assert is used to make sure no pointers passed in to the method are null. 
+ *Big-O notation: O(n)    where n = maxElts  (max length of the array data)
+ */
+char *findElementLen(SET *sp, char *elt, int length)
 {
 	assert(sp != NULL);
 	assert(elt != NULL);
 	bool found;
-	int location = search(sp, elt, &found);
+	int location = search(sp, elt, length, (*sp->hash)(elt, length), &found);
 	//checks if string exists in the set, and returns null if string isn't found in the set
 	if(found)
 	{
-		return sp->data[location];
+		return slotString(&sp->data[location]);
 	}	
 	return NULL; 		
 }
@@ -155,46 +223,133 @@ char **getElements(SET *sp)
 	//finds the location of each filled value in data, and adds those values to the array newData
 	for(dataIndex = 0; dataIndex < sp->length; dataIndex++)
 	{
-		if(sp->flags[dataIndex] == FILLED)
+		if(IS_FILLED(sp->flags[dataIndex]))
 		{
-			newData[newDataIndex] = sp->data[dataIndex];
+			newData[newDataIndex] = slotString(&sp->data[dataIndex]);
 			newDataIndex++;		
 		}		
 	}
 	return newData;	
 }
 
-/*Searches the set sp for a given string elt using sequential search. Returns the index of elt in the array data if found or the index of where the element should be placed if not found. A boolean called found is passed in by reference which represents if the element has been found or not, which is used to differentiate between wehther the returned value is the index where the element was found or is the index of where the element should be inputted. Assert is used to make sure no pointers passed in to method are null. 
+/*Stores string elt of the given length, which is less than SLOT_SIZE, in slot, followed by zeros and then SLOT_SIZE-1 minus its length in the last byte. A slot filled with the string being looked for can then be compared with a slot by a single 16-byte compare.
+ *Big-O notation: O(1)
+ */
+static void fillSlot(SLOT *slot, char *elt, int length)
+{
+	memset(slot->key, 0, SLOT_SIZE);
+	memcpy(slot->key, elt, length);
+	slot->key[SLOT_SIZE-1] = SLOT_SIZE - 1 - length;
+}
+
+/*Returns the string held by slot, which is either in the slot itself or in the arena.
+ *Big-O notation: O(1)
+ */
+static char *slotString(SLOT *slot)
+{
+	return (unsigned char)slot->key[SLOT_SIZE-1] == LONG ? slot->out.string : slot->key;
+}
+
+/*Returns whether slots a and b hold the same bytes, using a single SSE2 compare when it is available.
+ *Big-O notation: O(1)
+ */
+static bool sameSlot(SLOT *a, SLOT *b)
+{
+#ifdef __SSE2__
+	__m128i x = _mm_loadu_si128((__m128i*)a->key);
+	__m128i y = _mm_loadu_si128((__m128i*)b->key);
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) == 0xFFFF;
+#else
+	return memcmp(a->key, b->key, SLOT_SIZE) == 0;
+#endif
+}
+
+/*Sets the flag of slot location in set sp to flag. The first GROUP-1 flags are repeated after the end of the flags array, so that the flags of a group starting near the end of the table can be loaded all at once without wrapping around.
+ *Big-O notation: O(1)
+ */
+static void setFlag(SET *sp, int location, unsigned char flag)
+{
+	sp->flags[location] = flag;
+	if(location < GROUP - 1)
+	{
+		sp->flags[sp->length + location] = flag;
+	}
+}
+
+/*Returns a mask with bit i set for each of the GROUP flags starting at group that is equal to flag. Uses a single SSE2 compare when it is available.
+ *Big-O notation: O(1)
+ */
+static unsigned matchFlags(unsigned char *group, unsigned char flag)
+{
+#ifdef __SSE2__
+	__m128i flags = _mm_loadu_si128((__m128i*)group);
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(flags, _mm_set1_epi8(flag)));
+#else
+	unsigned mask = 0;
+	int i;
+	for(i = 0; i < GROUP; i++)
+	{
+		if(group[i] == flag)
+		{
+			mask |= 1u << i;
+		}
+	}
+	return mask;
+#endif
+}
+
+/*Searches the set sp for a given string elt of the given length whose hash is hash using linear probing, looking at GROUP slots at a time. Only the slots whose flag matches the 7 bits of hash given by TAG have their strings compared with elt. A short elt is placed in a slot of its own first, so that comparing it with a slot is a single 16-byte compare, while a long elt is only compared with long strings whose full hash and length match, and the search stops at the first group with an empty slot. Returns the index of elt in the array data if found or the index of where the element should be placed if not found, which is the first deleted or empty slot in the order the slots were probed. A boolean called found is passed in by reference which represents if the element has been found or not, which is used to differentiate between wehther the returned value is the index where the element was found or is the index of where the element should be inputted. Assert is used to make sure no pointers passed in to method are null. 
  *Big-O notation: O(n)   where n = maxElts  (max length of the array data)
  */
-static int search(SET *sp, char *elt, bool *found)
+static int search(SET *sp, char *elt, int length, unsigned hash, bool *found)
 {
 	assert(sp != NULL);
 	assert(elt != NULL);
 	assert(found != NULL);
-	int start = strhash(elt) % sp->length;
+	unsigned char tag = TAG(hash);
+	SLOT image;
+	bool isShort = length < SLOT_SIZE;
+	if(isShort)
+	{
+		fillSlot(&image, elt, length);
+	}
+	//a table smaller than a group is probed as a single shorter group
+	int width = sp->length < GROUP ? sp->length : GROUP;
+	unsigned valid = (1u << width) - 1;
+	int start = hash % sp->length;
 	int location;
 	int i;
-	bool deleteFound = false;
+	unsigned matches, empties, deletes;
 	int deleteIndex = -1; 
-	for(i = 0; i < sp->length; i++)
+	for(i = 0; i < sp->length; i += width)
 	{
-		location = (start + i) % sp->length;
-		if(sp->flags[location] == EMPTY)
+		unsigned char *group = sp->flags + start;
+		matches = matchFlags(group, tag) & valid;
+		while(matches != 0)
 		{
-			*found = false;
-			return deleteFound ? deleteIndex : location;  
+			location = (start + __builtin_ctz(matches)) % sp->length;
+			SLOT *slot = &sp->data[location];
+			if(isShort ? sameSlot(slot, &image) : (unsigned char)slot->key[SLOT_SIZE-1] == LONG && sp->hashes[location] == hash && slot->out.length == length && memcmp(slot->out.string, elt, length) == 0)
+			{
+				*found = true;
+				return location;
+			}
+			matches &= matches - 1;
 		}
-		else if(sp->flags[location] == DELETED && !deleteFound)
+
+		empties = matchFlags(group, EMPTY) & valid;
+		deletes = matchFlags(group, DELETED) & valid;
+		//a deleted slot only comes before the end of the search if it is before the first empty slot of the group
+		if(deleteIndex == -1 && deletes != 0 && (empties == 0 || __builtin_ctz(deletes) < __builtin_ctz(empties)))
 		{
-			deleteFound = true;
-			deleteIndex = location;				
+			deleteIndex = (start + __builtin_ctz(deletes)) % sp->length;
 		}
-		else if(strcmp(sp->data[location], elt) == 0)
+		if(empties != 0)
 		{
-			*found = true;
-			return location;
-		} 
+			*found = false;
+			return deleteIndex != -1 ? deleteIndex : (start + __builtin_ctz(empties)) % sp->length;  
+		}
+		start = (start + width) % sp->length;
 	} 
 
 	*found = false;
@@ -11,7 +11,10 @@
  *              are inserted into the set and the counts of total words and
  *              total words in the set are printed.  If the second file is
  *              given then all words in the second file are deleted from
- *              the set and the count printed.
+ *              the set and the count printed.  With -f, words are
+ *              lowercased and stripped of surrounding punctuation first.
+ *              With -h, the set hashes words with the named function from
+ *              hash.h instead of its own.
  */
 
 # include <stdio.h>
@@ -19,11 +22,16 @@
 # include <string.h>
 # include <stdbool.h>
 # include "set.h"
+# include "token.h"
+# include "hash.h"
 
 
-/* This is sufficient for the test cases in /scratch/coen12. */
+/* This is sufficient for the test cases in /scratch/coen12.  Larger inputs
+   can be run by compiling with -DMAX_SIZE=n. */
 
+# ifndef MAX_SIZE
 # define MAX_SIZE 18000
+# endif
 
 
 /*
@@ -34,45 +42,62 @@
 
 int main(int argc, char *argv[])
 {
-    FILE *fp;
-    char buffer[BUFSIZ], **elts;
+    TOKENIZER *tp;
+    char *word, **elts;
     SET *unique;
-    int i, words;
-    bool lflag = false;
+    int i, words, length, shift;
+    bool lflag = false, fflag = false;
+    HASHFUNC *hash = NULL;
 
 
     /* Check usage and open the first file. */
 
-    if (argc > 1 && strcmp(argv[1], "-l") == 0) {
-	lflag = true;
-	argc --;
+    while (argc > 1 && (strcmp(argv[1], "-l") == 0 ||
+	    strcmp(argv[1], "-f") == 0 || strcmp(argv[1], "-h") == 0)) {
+	shift = 1;
+
+	if (strcmp(argv[1], "-l") == 0)
+	    lflag = true;
+	else if (strcmp(argv[1], "-f") == 0)
+	    fflag = true;
+	else if (argc > 2 && (hash = findHash(argv[2])) != NULL)
+	    shift = 2;
+	else {
+	    argc = 1;
+	    break;
+	}
+
+	argc -= shift;
 
 	for (i = 1; i < argc; i ++)
-	    argv[i] = argv[i + 1];
+	    argv[i] = argv[i + shift];
     }
 
     if (argc == 1 || argc > 3) {
-        fprintf(stderr, "usage: %s [-l] file1 [file2]\n", argv[0]);
+        fprintf(stderr, "usage: %s [-l] [-f] [-h multiply|wide|crc] "
+	    "file1 [file2]\n", argv[0]);
         exit(EXIT_FAILURE);
     }
 
-    if ((fp = fopen(argv[1], "r")) == NULL) {
+    if ((tp = openTokenizer(argv[1])) == NULL) {
         fprintf(stderr, "%s: cannot open %s\n", argv[0], argv[1]);
         exit(EXIT_FAILURE);
     }
 
+    foldTokens(tp, fflag);
+
 
     /* Insert all words into the set. */
 
     words = 0;
-    unique = createSet(MAX_SIZE);
+    unique = hash != NULL ? createSetHash(MAX_SIZE, hash) : createSet(MAX_SIZE);
 
-    while (fscanf(fp, "%s", buffer) == 1) {
+    while ((word = nextToken(tp, &length)) != NULL) {
         words ++;
-        addElement(unique, buffer);
+        addElementLen(unique, word, length);
     }
 
-    fclose(fp);
+    closeTokenizer(tp);
 
     if (!lflag) {
 	printf("%d total words\n", words);
@@ -83,18 +108,20 @@ int main(int argc, char *argv[])
     /* Try to open the second file. */
 
     if (argc == 3) {
-        if ((fp = fopen(argv[2], "r")) == NULL) {
+        if ((tp = openTokenizer(argv[2])) == NULL) {
             fprintf(stderr, "%s: cannot open %s\n", argv[0], argv[2]);
             exit(EXIT_FAILURE);
         }
 
+	foldTokens(tp, fflag);
+
 
         /* Delete all words in the second file. */
 
-        while (fscanf(fp, "%s", buffer) == 1)
-            removeElement(unique, buffer);
+        while ((word = nextToken(tp, &length)) != NULL)
+            removeElementLen(unique, word, length);
 
-	fclose(fp);
+	closeTokenizer(tp);
 
 	if (!lflag)
 	    printf("%d remaining words\n", numElements(unique));
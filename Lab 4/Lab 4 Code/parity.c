@@ -16,11 +16,15 @@
 # include <stdlib.h>
 # include <string.h>
 # include "set.h"
+# include "token.h"
 
 
-/* This is sufficient for the test cases in /scratch/coen12. */
+/* This is sufficient for the test cases in /scratch/coen12.  Larger inputs
+   can be run by compiling with -DMAX_SIZE=n. */
 
+# ifndef MAX_SIZE
 # define MAX_SIZE 18000
+# endif
 
 
 /*
@@ -49,10 +53,10 @@ static unsigned strhash(char *s)
 
 int main(int argc, char *argv[])
 {
-    FILE *fp;
-    char buffer[BUFSIZ], *word;
+    TOKENIZER *tp;
+    char *word, *elt;
     SET *odd;
-    int words;
+    int words, length;
 
 
     /* Check usage and open the file. */
@@ -62,7 +66,7 @@ int main(int argc, char *argv[])
         exit(EXIT_FAILURE);
     }
 
-    if ((fp = fopen(argv[1], "r")) == NULL) {
+    if ((tp = openTokenizer(argv[1])) == NULL) {
         fprintf(stderr, "%s: cannot open %s\n", argv[0], argv[1]);
         exit(EXIT_FAILURE);
     }
@@ -73,19 +77,19 @@ int main(int argc, char *argv[])
     words = 0;
     odd = createSet(MAX_SIZE, strcmp, strhash);
 
-    while (fscanf(fp, "%s", buffer) == 1) {
+    while ((word = nextToken(tp, &length)) != NULL) {
         words ++;
 
-        if ((word = findElement(odd, buffer)) != NULL) {
-            removeElement(odd, buffer);
-	    free(word);
+        if ((elt = findElement(odd, word)) != NULL) {
+            removeElement(odd, word);
+	    free(elt);
 	} else
-            addElement(odd, strdup(buffer));
+            addElement(odd, copyToken(word, length));
     }
 
     printf("%d total words\n", words);
     printf("%d words occur an odd number of times\n", numElements(odd));
-    fclose(fp);
+    closeTokenizer(tp);
 
     destroySet(odd);
     exit(EXIT_SUCCESS);
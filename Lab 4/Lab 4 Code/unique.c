@@ -19,11 +19,15 @@
 # include <string.h>
 # include <stdbool.h>
 # include "set.h"
+# include "token.h"
 
 
-/* This is sufficient for the test cases in /scratch/coen12. */
+/* This is sufficient for the test cases in /scratch/coen12.  Larger inputs
+   can be run by compiling with -DMAX_SIZE=n. */
 
+# ifndef MAX_SIZE
 # define MAX_SIZE 18000
+# endif
 
 
 /*
@@ -52,10 +56,10 @@ static unsigned strhash(char *s)
 
 int main(int argc, char *argv[])
 {
-    FILE *fp;
-    char buffer[BUFSIZ], **elts, *word;
+    TOKENIZER *tp;
+    char *word, *elt, **elts;
     SET *unique;
-    int i, words;
+    int i, words, length;
     bool lflag = false;
 
 
@@ -74,7 +78,7 @@ int main(int argc, char *argv[])
         exit(EXIT_FAILURE);
     }
 
-    if ((fp = fopen(argv[1], "r")) == NULL) {
+    if ((tp = openTokenizer(argv[1])) == NULL) {
         fprintf(stderr, "%s: cannot open %s\n", argv[0], argv[1]);
         exit(EXIT_FAILURE);
     }
@@ -85,13 +89,13 @@ int main(int argc, char *argv[])
     words = 0;
     unique = createSet(MAX_SIZE, strcmp, strhash);
 
-    while (fscanf(fp, "%s", buffer) == 1) {
+    while ((word = nextToken(tp, &length)) != NULL) {
         words ++;
-	if (!findElement(unique, buffer))
-	    addElement(unique, strdup(buffer));
+	if (!findElement(unique, word))
+	    addElement(unique, copyToken(word, length));
     }
 
-    fclose(fp);
+    closeTokenizer(tp);
 
     if (!lflag) {
 	printf("%d total words\n", words);
@@ -102,7 +106,7 @@ int main(int argc, char *argv[])
     /* Try to open the second file. */
 
     if (argc == 3) {
-        if ((fp = fopen(argv[2], "r")) == NULL) {
+        if ((tp = openTokenizer(argv[2])) == NULL) {
             fprintf(stderr, "%s: cannot open %s\n", argv[0], argv[2]);
             exit(EXIT_FAILURE);
         }
@@ -110,14 +114,14 @@ int main(int argc, char *argv[])
 
         /* Delete all words in the second file. */
 
-        while (fscanf(fp, "%s", buffer) == 1) {
-	    if ((word = findElement(unique, buffer)) != NULL) {
-		removeElement(unique, buffer);
-		free(word);
+        while ((word = nextToken(tp, &length)) != NULL) {
+	    if ((elt = findElement(unique, word)) != NULL) {
+		removeElement(unique, word);
+		free(elt);
 	    }
 	}
 
-	fclose(fp);
+	closeTokenizer(tp);
 
 	if (!lflag)
 	    printf("%d remaining words\n", numElements(unique));
@@ -13,9 +13,8 @@
 # include <stdlib.h>
 # include <string.h>
 # include "list.h"
-
-
-# define MAX_WORD_LENGTH 30		/* maximum length of a single word */
+# include "token.h"
+# include "arena.h"
 
 
 /*
@@ -86,9 +85,11 @@ static void quickSort(LIST *lp, int lo, int hi)
 
 int main(int argc, char *argv[])
 {
-    FILE *fp;
+    TOKENIZER *tp;
     LIST *words;
-    char word[MAX_WORD_LENGTH+1];
+    ARENA *ap;
+    char *word;
+    int length;
 
 
     /* Check the number of arguments and try to open the file. */
@@ -98,22 +99,25 @@ int main(int argc, char *argv[])
 	exit(EXIT_FAILURE);
     }
 
-    fp = fopen(argv[1], "r");
+    tp = openTokenizer(argv[1]);
 
-    if (fp == NULL) {
+    if (tp == NULL) {
 	fprintf(stderr, "cannot open file\n");
 	exit(EXIT_FAILURE);
     }
 
 
-    /* Read each word into the buffer and add it to the list. */
+    /* Read each word and add a copy of it to the list.  The copies are
+       interned in an arena, so a word that appears many times is only
+       stored once and all of them are freed together at the end. */
 
     words = createList();
+    ap = createArena(true);
 
-    while (fscanf(fp, "%s", word) == 1)
-	addLast(words, strdup(word));
+    while ((word = nextToken(tp, &length)) != NULL)
+	addLast(words, copyArena(ap, word, length));
 
-    fclose(fp);
+    closeTokenizer(tp);
 
 
     /* Sort the words in the list and print them out in sorted order. */
@@ -124,5 +128,6 @@ int main(int argc, char *argv[])
 	printf("%s\n", (char *) removeFirst(words));
 
     destroyList(words);
+    destroyArena(ap);
     exit(EXIT_SUCCESS);
 }